@@ -104,21 +104,30 @@ public:
           "Ouput snapshot to file");
     }
 
+    /// The phylogeny is not saved in checkpoints; a restored run starts a new one.
+    bool SaveState(std::ostream &) const override { return false; }
+
     void BeforeDeath(OrgPosition pos) override {
       // Notify the systematics manager when an organism dies.
       sys.RemoveOrg({pos.Pos(), (size_t)pos.PopID()});
     }
 
-    void BeforePlacement(Organism& org, OrgPosition pos, OrgPosition ppos) override {
-      // Notify the systematics manager when an organism is born.
-      if (ppos.IsValid()) {
-        sys.AddOrg(org, {pos.Pos(), (size_t)pos.PopID()}, {ppos.Pos(), (size_t)ppos.PopID()});
-      } else {
-        // We're injecting so no parent
-        // Double-check that this is happening because pop is null,
-        // not because parent position is illegal
-        // emp_assert(ppos.PopPtr().IsNull() && "Illegal parent position");
-        sys.AddOrg(org, {pos.Pos(), (size_t)pos.PopID()}, nullptr);
+    void BeforePlacementBatch(std::span<const emp::Ptr<Organism>> orgs,
+                              std::span<const OrgPosition> positions,
+                              std::span<const OrgPosition> parent_positions) override {
+      // Notify the systematics manager when organisms are born.
+      for (size_t i = 0; i < orgs.size(); ++i) {
+        const OrgPosition pos = positions[i];
+        const OrgPosition ppos = parent_positions[i];
+        if (ppos.IsValid()) {
+          sys.AddOrg(*orgs[i], {pos.Pos(), (size_t)pos.PopID()}, {ppos.Pos(), (size_t)ppos.PopID()});
+        } else {
+          // We're injecting so no parent
+          // Double-check that this is happening because pop is null,
+          // not because parent position is illegal
+          // emp_assert(ppos.PopPtr().IsNull() && "Illegal parent position");
+          sys.AddOrg(*orgs[i], {pos.Pos(), (size_t)pos.PopID()}, nullptr);
+        }
       }
     }
 
@@ -126,6 +135,15 @@ public:
       // Notify the systematics manager when an organism is moved.
       sys.SwapPositions({pos1.Pos(), (size_t)pos1.PopID()}, {pos2.Pos(), (size_t)pos2.PopID()});
     }
+
+    void OnPopReplace(Population & to_pop, Population & from_pop) override {
+      // Notify the systematics manager about all organisms moved between populations.
+      const size_t to_id = (size_t) to_pop.GetID();
+      const size_t from_id = (size_t) from_pop.GetID();
+      for (size_t pos : to_pop.GetLivingPositions()) {
+        sys.SwapPositions({pos, from_id}, {pos, to_id});
+      }
+    }
 };
 
     MABE_REGISTER_MODULE(AnalyzeSystematics, "Module to track the population's phylogeny.");
@@ -17,8 +17,10 @@
 #define MABE_ACTION_MAP_H
 
 
+#include <any>
 #include <functional>
 #include <unordered_map>
+#include <utility>
 #include "emp/base/assert.hpp"
 #include "emp/base/vector.hpp"
 #include "emp/functional/AnyFunction.hpp"
@@ -32,6 +34,7 @@ namespace mabe {
   struct Action{
     std::string name;  ///< Human-readable name of an action
     emp::vector<emp::AnyFunction> function_vec; ///< Collection of functions associated with this action
+    emp::vector<std::any> typed_vec; ///< Typed std::function for each entry in function_vec (if known)
     emp::DataMap data; ///< Generic datamap for any additional data a module wants the organism to have 
 
     Action(const std::string& _name, emp::AnyFunction _func) :
@@ -45,6 +48,34 @@ namespace mabe {
         function_vec(),
         data(){ ; }
     Action() = default;
+
+    /// Resolve all functions of this action into a single callable, once (e.g., at setup), so
+    /// that calls skip the type check of AnyFunction::Call.  An action with one function returns
+    /// that function directly; multiple functions (e.g., IO plus an evaluator) are fused into
+    /// one call that runs them in order.
+    template <typename... PARAMS>
+    std::function<void(PARAMS...)> BuildDispatch() {
+      using fun_t = std::function<void(PARAMS...)>;
+      emp::vector<fun_t> funs;
+      for (size_t func_idx = 0; func_idx < function_vec.size(); ++func_idx) {
+        const fun_t * typed_fun = nullptr;
+        if (func_idx < typed_vec.size()) typed_fun = std::any_cast<fun_t>(&typed_vec[func_idx]);
+        if (typed_fun) funs.push_back(*typed_fun);
+        else { // Type not known in advance; fall back to a checked call.
+          emp::AnyFunction any_fun = function_vec[func_idx];
+          funs.push_back([any_fun](PARAMS... args) mutable {
+            any_fun.Call<void, PARAMS...>(std::forward<PARAMS>(args)...);
+          });
+        }
+      }
+
+      if (funs.size() == 0) return [](PARAMS...){ ; };
+      if (funs.size() == 1) return funs[0];
+      if (funs.size() == 2) {
+        return [fun0=funs[0], fun1=funs[1]](PARAMS... args){ fun0(args...); fun1(args...); };
+      }
+      return [funs](PARAMS... args){ for (const fun_t & fun : funs) fun(args...); };
+    }
   };
 
   /// \brief An inter-module collection of functions that can be called by organisms. Functions are accessed by their type signature. 
@@ -69,8 +100,10 @@ namespace mabe {
       }
       Action& action = action_map.at(name);
 
-      emp::vector<emp::AnyFunction>& action_vec = action.function_vec;
-      action_vec.emplace_back(in_func);
+      // Keep typed_vec parallel to function_vec, even if functions were added elsewhere.
+      action.typed_vec.resize(action.function_vec.size());
+      action.function_vec.emplace_back(in_func);
+      action.typed_vec.emplace_back(in_func);
       return action;
     }
 
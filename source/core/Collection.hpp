@@ -29,7 +29,8 @@
  *  .ToString() provides a string version of this collection for human readability.
  * 
  *  .Insert(item) will allow you to insert an organism position, a populaiton, or another
- *  collection into this collection.
+ *  collection into this collection.  .InsertPositions(pop, bit_vector) adds many positions
+ *  from a single population at once.
  * 
  *  .Clear() empties this collection.
  * 
@@ -49,6 +50,10 @@
  *  Internally, a Collection is represented by a map; keys are pointers to the included Populations
  *  and values are a PopInfo class (a flag for "do we included the whole population" and a
  *  BitVector indicating the positions that are included if not the whole population).
+ *
+ *  Each PopInfo lazily builds a rank index over its BitVector (the number of included positions
+ *  before each 64-bit word), so sizes are cached and the position of the n'th included organism
+ *  can be found with a binary search; any change to the BitVector clears the index.
  * 
  *  A CollectionIterator will track the current population being iterated through, and the position
  *  currently indicated.  When an iterator reached the end, it's population pointer is set to 
@@ -58,6 +63,8 @@
 #ifndef MABE_COLLECTION_H
 #define MABE_COLLECTION_H
 
+#include <algorithm>
+#include <bit>
 #include <set>
 #include <string>
 #include <sstream>
@@ -163,11 +170,33 @@ namespace mabe {
       bool is_mutable = false; ///< Are we allowed to change this population?
       emp::BitVector pos_set;  ///< Which positions are we using for this population?
 
+      // Rank index over pos_set; built on demand and cleared by ClearIndex() on any change.
+      mutable emp::vector<size_t> word_ranks;  ///< Positions included before each 64-bit word.
+      mutable size_t num_included = 0;         ///< Total positions included in pos_set.
+      mutable bool index_ok = false;           ///< Is the index up to date?
+
+      /// Must be called whenever pos_set is modified.
+      void ClearIndex() { index_ok = false; }
+
+      void BuildIndex() const {
+        if (index_ok) return;
+        const size_t num_words = (pos_set.GetSize() + 63) / 64;
+        word_ranks.resize(num_words);
+        size_t total = 0;
+        for (size_t word_id = 0; word_id < num_words; ++word_id) {
+          word_ranks[word_id] = total;
+          total += (size_t) std::popcount(pos_set.GetUInt64(word_id));
+        }
+        num_included = total;
+        index_ok = true;
+      }
+
       /// Identify how many positions we have.
       size_t GetSize(pop_ptr_t pop_ptr) const {
         if (full_pop) return pop_ptr->GetSize();
         emp_assert(pop_ptr->GetSize() >= pos_set.GetSize(), pop_ptr->GetSize(), pos_set.GetSize());
-        return pos_set.CountOnes();
+        BuildIndex();
+        return num_included;
       }
 
       /// Return the first legal position in the population (or 0 if none exist, which
@@ -185,15 +214,20 @@ namespace mabe {
       }
 
       /// Remap an ID from the collection to a population position.
-      size_t GetPos(size_t org_id) {
+      size_t GetPos(size_t org_id) const {
         if (full_pop) return org_id;
-
-        size_t cur_pos = pos_set.FindOne();
-        while(org_id) {
-          org_id--;
-          cur_pos = pos_set.FindOne(cur_pos+1);
-        }
-        return cur_pos;
+        BuildIndex();
+        emp_assert(org_id < num_included, org_id, num_included);
+
+        // Find the last word that starts at or before org_id; any empty words before it share
+        // its rank, so upper_bound skips past them.
+        auto rank_it = std::upper_bound(word_ranks.begin(), word_ranks.end(), org_id);
+        const size_t word_id = (size_t) (rank_it - word_ranks.begin()) - 1;
+
+        // Drop the lowest set bits until the requested one is lowest.
+        uint64_t word = pos_set.GetUInt64(word_id);
+        for (size_t skip = org_id - word_ranks[word_id]; skip > 0; --skip) word &= word - 1;
+        return word_id * 64 + (size_t) std::countr_zero(word);
       }
 
       /// Insert a single position into the pos_set.
@@ -202,6 +236,7 @@ namespace mabe {
         // Make sure we have room for this position and then set it.
         if (pos_set.GetSize() <= pos) pos_set.Resize(pos+1);
         pos_set.Set(pos);
+        ClearIndex();
       }
 
       /// Shift this population to using the pos_set.
@@ -210,9 +245,10 @@ namespace mabe {
         pos_set.Resize(pop_ptr->GetSize()); // Resize position set to have room for all positions.
         pos_set.SetAll();                   // Initially include all orgs.
         full_pop = false;                   // Record that pop is no longer officially full.
+        ClearIndex();
       }
 
-      bool IsEmpty(pop_ptr_t pop_ptr) {
+      bool IsEmpty(pop_ptr_t pop_ptr) const {
         if (full_pop) return pop_ptr->IsEmpty();
         size_t cur_pos = 0;
         while(cur_pos < pop_ptr->GetSize()) {
@@ -367,7 +403,7 @@ namespace mabe {
     /// Calculate the total number of positions represented in this collection.
     size_t GetSize() const noexcept override {
       size_t count = 0;
-      for (auto [pop_ptr, pop_info] : pos_map) {
+      for (const auto & [pop_ptr, pop_info] : pos_map) {
         count += pop_info.GetSize(pop_ptr);
       }
       return count;
@@ -376,18 +412,33 @@ namespace mabe {
     /// Determine if there are any (living) organisms in this collection.
     bool IsEmpty() const noexcept override {
       // If we find an organism in any population, return false; otherwise return true.
-      for (auto [pop_ptr, pop_info] : pos_map) {
+      for (auto & [pop_ptr, pop_info] : pos_map) {
         if (!pop_info.IsEmpty(pop_ptr)) return false;
       }
       return true;
     }
 
-    iterator_t IteratorAt(size_t org_id) { return iterator_t(*this, org_id); }
-    const_iterator_t IteratorAt(size_t org_id) const { return const_iterator_t(*this, org_id); }
+    /// Get an iterator to the org_id'th position in this collection (or end() if out of range).
+    iterator_t IteratorAt(size_t org_id) {
+      for (const auto & [pop_ptr, pop_info] : pos_map) {
+        const size_t pop_size = pop_info.GetSize(pop_ptr);
+        if (org_id < pop_size) return iterator_t(this, pop_ptr, pop_info.GetPos(org_id));
+        org_id -= pop_size;
+      }
+      return end();
+    }
+    const_iterator_t IteratorAt(size_t org_id) const {
+      for (const auto & [pop_ptr, pop_info] : pos_map) {
+        const size_t pop_size = pop_info.GetSize(pop_ptr);
+        if (org_id < pop_size) return const_iterator_t(this, pop_ptr, pop_info.GetPos(org_id));
+        org_id -= pop_size;
+      }
+      return end();
+    }
     const_iterator_t ConstIteratorAt(size_t org_id) const { return IteratorAt(org_id); }
 
     Organism & At(size_t org_id) override {
-      for (auto [pop_ptr, pop_info] : pos_map) {
+      for (const auto & [pop_ptr, pop_info] : pos_map) {
         const size_t pop_size = pop_info.GetSize(pop_ptr);
 
         // If the ID is in the current population, get it.
@@ -407,12 +458,13 @@ namespace mabe {
     }
 
     const Organism & At(size_t org_id) const override {
-      for (auto [pop_ptr, pop_info] : pos_map) {
-        if (org_id < pop_info.GetSize(pop_ptr)) {
+      for (const auto & [pop_ptr, pop_info] : pos_map) {
+        const size_t pop_size = pop_info.GetSize(pop_ptr);
+        if (org_id < pop_size) {
           size_t pop_id = pop_info.GetPos(org_id);
           return pop_ptr->At(pop_id);
         }
-        org_id -= pop_info.GetSize(pop_ptr);
+        org_id -= pop_size;
       }
 
       emp::notify::Error("Trying to find org id out of range for a collection.");
@@ -440,7 +492,7 @@ namespace mabe {
     std::string ToString() const override {
       std::stringstream ss;
       bool first = true;
-      for (auto [pop_ptr, pop_info] : pos_map) {
+      for (const auto & [pop_ptr, pop_info] : pos_map) {
         if (first) first = false;
         else ss << ',';
 
@@ -598,6 +650,7 @@ namespace mabe {
 
         // Use 'OR' to find the union of the sets.
         pos_set |= in_pos_set;
+        pop_info.ClearIndex();
       }
 
       return Insert( std::forward<Ts>(extras)... );  // Insert anything else provided.
@@ -606,6 +659,24 @@ namespace mabe {
     /// Base case... nothing left to insert.
     Collection & Insert() { return *this; }
 
+    /// Add a whole set of positions from a single population at once.
+    Collection & InsertPositions(Population & pop, const emp::BitVector & positions) {
+      PopInfo & pop_info = pos_map[&pop];
+      pop_info.is_mutable = true;
+      if (pop_info.full_pop) return *this;
+
+      emp::BitVector & pos_set = pop_info.pos_set;
+      if (pos_set.GetSize() < positions.GetSize()) pos_set.Resize(positions.GetSize());
+      if (pos_set.GetSize() == positions.GetSize()) pos_set |= positions;
+      else {
+        emp::BitVector in_pos_set = positions;
+        in_pos_set.Resize(pos_set.GetSize());
+        pos_set |= in_pos_set;
+      }
+      pop_info.ClearIndex();
+      return *this;
+    }
+
     /// Set this collection to be exactly the provided items.
     template <typename... Ts>
     Collection & Set(Ts &&...args) {
@@ -626,14 +697,22 @@ namespace mabe {
       for (auto & [pop_ptr, pop_info] : pos_map) {
         emp::BitVector & pos_set = pop_info.pos_set;
 
-        // Make sure this population isn't full.  Even if there a no empty cells, the
-        // remove empty command should limit us to only the existing positions.
-        pop_info.RemoveFull(pop_ptr); 
+        // If we have a full population, rebuild the position set directly from the living
+        // organisms rather than scanning all positions.
+        if (pop_info.full_pop) {
+          pos_set.Resize(pop_ptr->GetSize());
+          pos_set.Clear();
+          for (size_t pos : pop_ptr->GetLivingPositions()) pos_set.Set(pos);
+          pop_info.full_pop = false;
+          pop_info.ClearIndex();
+          continue;
+        }
 
         // Scan through organisms, removing inclusion of those that are empty.
         for (int pos = pos_set.FindOne(); pos != -1; pos = pos_set.FindOne(pos+1)) {
           if (!pop_ptr->IsOccupied((size_t) pos)) pos_set.Set(pos,false);
         }
+        pop_info.ClearIndex();
       }
 
       return *this;
@@ -669,6 +748,7 @@ namespace mabe {
         if (!in_it->second.full_pop) {
           cur_it->second.RemoveFull(cur_it->first);         // Shift first pop to individuals
           cur_it->second.pos_set &= in_it->second.pos_set;  // Now pick out the intersection.
+          cur_it->second.ClearIndex();
         }
 
         // Move on to the next populations.
@@ -0,0 +1,324 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  EquationVM.hpp
+ *  @brief Compiles trait equations to flat register bytecode for fast (batched) evaluation.
+ *
+ *  emp::SimpleParser builds an equation as a tree of nested closures and looks up each trait as
+ *  it goes.  An EquationProgram instead compiles the equation once into a short list of register
+ *  instructions, with every trait resolved to a DataMap ID and type.  Run() evaluates it for a
+ *  single DataMap; RunBatch() evaluates it for many at a time, gathering each trait into a lane
+ *  array and then applying each instruction across all lanes in a tight (vectorizable) loop.
+ *
+ *  Only a conservative subset of the equation language is compiled: numbers, preserved values
+ *  ($0, $1, ...), single numeric traits, parentheses, unary - and !, binary + - * /, the
+ *  comparisons (< <= > >= == !=), && and ||, and the functions ABS, CEIL, EXP, FLOOR, LOG2,
+ *  LOG10, SQRT, MIN, MAX, POW, and IF.  Compile() returns false for anything else, and the
+ *  caller should fall back to the general parser.
+ */
+
+#ifndef MABE_EQUATION_VM_H
+#define MABE_EQUATION_VM_H
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/data/DataLayout.hpp"
+#include "emp/data/DataMap.hpp"
+
+#include "TraitColumns.hpp"
+
+namespace mabe {
+
+  class EquationProgram {
+  public:
+    static constexpr size_t MAX_REGS = 32;     ///< Deeper equations use the general parser.
+    static constexpr size_t BATCH_SIZE = 128;  ///< Lanes evaluated together by RunBatch().
+
+  private:
+    using Kind = TraitColumns::Kind;
+
+    enum class Op : uint8_t {
+      CONST, LOAD,
+      NEG, NOT, ABS, CEIL, EXP, FLOOR, LOG2, LOG10, SQRT,
+      ADD, SUB, MUL, DIV, LT, LE, GT, GE, EQ, NE, AND, OR, MIN, MAX, POW,
+      IF
+    };
+
+    struct Inst {
+      Op op;
+      uint8_t dest = 0;     ///< Register for the result (also the first operand).
+      uint8_t arg1 = 0;     ///< Second operand register.
+      uint8_t arg2 = 0;     ///< Third operand register (IF only).
+      uint32_t index = 0;   ///< Constant (CONST) or trait load (LOAD) to use.
+    };
+
+    struct Load {
+      size_t trait_id;
+      Kind kind;
+    };
+
+    emp::vector<Inst> code;
+    emp::vector<double> constants;
+    emp::vector<Load> loads;
+    size_t num_regs = 0;
+    bool is_compiled = false;
+
+    // ---- Compiling ----
+
+    /// Recursive-descent compiler; each Compile function leaves its result in register 'reg'.
+    struct Compiler {
+      EquationProgram & prog;
+      const emp::DataLayout & layout;
+      const emp::vector<double> & preserved;
+      std::string_view text;
+      size_t pos = 0;
+      bool ok = true;
+
+      void Fail() { ok = false; }
+
+      void SkipSpace() {
+        while (pos < text.size() && std::isspace((unsigned char) text[pos])) ++pos;
+      }
+
+      bool Match(std::string_view token) {
+        SkipSpace();
+        if (text.substr(pos, token.size()) != token) return false;
+        pos += token.size();
+        return true;
+      }
+
+      void Emit(Op op, size_t dest, size_t arg1=0, size_t arg2=0, size_t index=0) {
+        if (dest + 1 > prog.num_regs) prog.num_regs = dest + 1;
+        if (prog.num_regs > MAX_REGS) { Fail(); return; }
+        prog.code.push_back(Inst{op, (uint8_t) dest, (uint8_t) arg1, (uint8_t) arg2,
+                                 (uint32_t) index});
+      }
+
+      void EmitConst(size_t reg, double value) {
+        prog.constants.push_back(value);
+        Emit(Op::CONST, reg, 0, 0, prog.constants.size() - 1);
+      }
+
+      std::string ReadName() {
+        SkipSpace();
+        const size_t start = pos;
+        while (pos < text.size() && (std::isalnum((unsigned char) text[pos]) || text[pos] == '_')) {
+          ++pos;
+        }
+        return std::string(text.substr(start, pos - start));
+      }
+
+      void CompileFunction(const std::string & name, size_t reg) {
+        struct FunInfo { const char * name; Op op; size_t num_args; };
+        static constexpr FunInfo funs[] = {
+          {"ABS", Op::ABS, 1}, {"CEIL", Op::CEIL, 1}, {"EXP", Op::EXP, 1},
+          {"FLOOR", Op::FLOOR, 1}, {"LOG2", Op::LOG2, 1}, {"LOG10", Op::LOG10, 1},
+          {"SQRT", Op::SQRT, 1}, {"MIN", Op::MIN, 2}, {"MAX", Op::MAX, 2},
+          {"POW", Op::POW, 2}, {"IF", Op::IF, 3}
+        };
+        for (const FunInfo & fun : funs) {
+          if (name != fun.name) continue;
+          for (size_t arg = 0; arg < fun.num_args && ok; ++arg) {
+            if (arg && !Match(",")) { Fail(); return; }
+            CompileExpr(reg + arg, 0);
+          }
+          if (!Match(")")) { Fail(); return; }
+          Emit(fun.op, reg, fun.num_args > 1 ? reg + 1 : 0, fun.num_args > 2 ? reg + 2 : 0);
+          return;
+        }
+        Fail();  // Unknown (or unsupported) function.
+      }
+
+      void CompileAtom(size_t reg) {
+        SkipSpace();
+        if (pos >= text.size()) { Fail(); return; }
+        const char c = text[pos];
+
+        if (Match("(")) {
+          CompileExpr(reg, 0);
+          if (!Match(")")) Fail();
+        }
+        else if (Match("-")) { CompileAtom(reg); Emit(Op::NEG, reg); }
+        else if (Match("!")) { CompileAtom(reg); Emit(Op::NOT, reg); }
+        else if (std::isdigit((unsigned char) c) || c == '.') {
+          const std::string num_text(text.substr(pos));
+          char * end = nullptr;
+          const double value = std::strtod(num_text.c_str(), &end);
+          if (end == num_text.c_str()) { Fail(); return; }
+          pos += (size_t) (end - num_text.c_str());
+          EmitConst(reg, value);
+        }
+        else if (c == '$') {
+          ++pos;
+          const size_t start = pos;
+          while (pos < text.size() && std::isdigit((unsigned char) text[pos])) ++pos;
+          if (pos == start) { Fail(); return; }
+          const size_t id = (size_t) std::stoul(std::string(text.substr(start, pos - start)));
+          if (id >= preserved.size()) { Fail(); return; }
+          EmitConst(reg, preserved[id]);
+        }
+        else if (std::isalpha((unsigned char) c) || c == '_') {
+          const std::string name = ReadName();
+          if (Match("(")) { CompileFunction(name, reg); return; }
+          if (!layout.HasName(name)) { Fail(); return; }
+          const size_t trait_id = layout.GetID(name);
+          const Kind kind = TraitColumns::GetKind(layout.GetType(trait_id));
+          if (kind == Kind::UNKNOWN || layout.GetCount(trait_id) != 1) { Fail(); return; }
+          prog.loads.push_back(Load{trait_id, kind});
+          Emit(Op::LOAD, reg, 0, 0, prog.loads.size() - 1);
+        }
+        else Fail();
+      }
+
+      /// Compile an expression whose binary operators all have precedence >= min_prec.
+      void CompileExpr(size_t reg, int min_prec) {
+        struct OpInfo { std::string_view token; Op op; int prec; };
+        static constexpr OpInfo ops[] = {   // Longer tokens first, so "<=" is not read as "<".
+          {"||", Op::OR, 1}, {"&&", Op::AND, 2}, {"==", Op::EQ, 3}, {"!=", Op::NE, 3},
+          {"<=", Op::LE, 4}, {">=", Op::GE, 4}, {"<", Op::LT, 4}, {">", Op::GT, 4},
+          {"+", Op::ADD, 5}, {"-", Op::SUB, 5}, {"*", Op::MUL, 6}, {"/", Op::DIV, 6}
+        };
+
+        CompileAtom(reg);
+        while (ok) {
+          SkipSpace();
+          if (pos >= text.size()) return;
+          const OpInfo * found = nullptr;
+          for (const OpInfo & info : ops) {
+            if (text.substr(pos, info.token.size()) == info.token) { found = &info; break; }
+          }
+          if (!found || found->prec < min_prec) return;   // Let the caller handle it.
+          pos += found->token.size();
+          CompileExpr(reg + 1, found->prec + 1);           // All operators are left-associative.
+          Emit(found->op, reg, reg + 1);
+        }
+      }
+    };
+
+    static double ReadTrait(const emp::DataMap & dm, const Load & load) {
+      switch (load.kind) {
+        case Kind::DOUBLE: return dm.Get<double>(load.trait_id);
+        case Kind::FLOAT:  return (double) dm.Get<float>(load.trait_id);
+        case Kind::INT:    return (double) dm.Get<int>(load.trait_id);
+        case Kind::UINT64: return (double) dm.Get<uint64_t>(load.trait_id);
+        case Kind::INT64:  return (double) dm.Get<int64_t>(load.trait_id);
+        case Kind::UINT32: return (double) dm.Get<uint32_t>(load.trait_id);
+        case Kind::BOOL:   return (double) dm.Get<bool>(load.trait_id);
+        case Kind::UNKNOWN: break;
+      }
+      emp_assert(false, "Trait cannot be read as a number.");
+      return 0.0;
+    }
+
+    /// Apply an arithmetic instruction to 'count' lanes of its registers.
+    static void Apply(Op op, double * a, const double * b, const double * c, size_t count) {
+      #define MABE_EQU_LOOP(EXPR) for (size_t i = 0; i < count; ++i) a[i] = (EXPR); break;
+      switch (op) {
+        case Op::NEG:   MABE_EQU_LOOP(-a[i])
+        case Op::NOT:   MABE_EQU_LOOP(a[i] == 0.0 ? 1.0 : 0.0)
+        case Op::ABS:   MABE_EQU_LOOP(std::abs(a[i]))
+        case Op::CEIL:  MABE_EQU_LOOP(std::ceil(a[i]))
+        case Op::EXP:   MABE_EQU_LOOP(std::exp(a[i]))
+        case Op::FLOOR: MABE_EQU_LOOP(std::floor(a[i]))
+        case Op::LOG2:  MABE_EQU_LOOP(std::log2(a[i]))
+        case Op::LOG10: MABE_EQU_LOOP(std::log10(a[i]))
+        case Op::SQRT:  MABE_EQU_LOOP(std::sqrt(a[i]))
+        case Op::ADD:   MABE_EQU_LOOP(a[i] + b[i])
+        case Op::SUB:   MABE_EQU_LOOP(a[i] - b[i])
+        case Op::MUL:   MABE_EQU_LOOP(a[i] * b[i])
+        case Op::DIV:   MABE_EQU_LOOP(a[i] / b[i])
+        case Op::LT:    MABE_EQU_LOOP(a[i] < b[i] ? 1.0 : 0.0)
+        case Op::LE:    MABE_EQU_LOOP(a[i] <= b[i] ? 1.0 : 0.0)
+        case Op::GT:    MABE_EQU_LOOP(a[i] > b[i] ? 1.0 : 0.0)
+        case Op::GE:    MABE_EQU_LOOP(a[i] >= b[i] ? 1.0 : 0.0)
+        case Op::EQ:    MABE_EQU_LOOP(a[i] == b[i] ? 1.0 : 0.0)
+        case Op::NE:    MABE_EQU_LOOP(a[i] != b[i] ? 1.0 : 0.0)
+        case Op::AND:   MABE_EQU_LOOP((a[i] != 0.0 && b[i] != 0.0) ? 1.0 : 0.0)
+        case Op::OR:    MABE_EQU_LOOP((a[i] != 0.0 || b[i] != 0.0) ? 1.0 : 0.0)
+        case Op::MIN:   MABE_EQU_LOOP(std::min(a[i], b[i]))
+        case Op::MAX:   MABE_EQU_LOOP(std::max(a[i], b[i]))
+        case Op::POW:   MABE_EQU_LOOP(std::pow(a[i], b[i]))
+        case Op::IF:    MABE_EQU_LOOP(a[i] != 0.0 ? b[i] : c[i])
+        case Op::CONST: case Op::LOAD:
+          emp_assert(false, "CONST and LOAD are not arithmetic instructions.");
+          break;
+      }
+      #undef MABE_EQU_LOOP
+    }
+
+  public:
+    /// Compile an equation for organisms using the given layout; preserved values replace $0,
+    /// $1, etc.  Return false if the equation uses anything that cannot be compiled.
+    bool Compile(const emp::DataLayout & layout, std::string_view equation,
+                 const emp::vector<double> & preserved) {
+      code.resize(0);
+      constants.resize(0);
+      loads.resize(0);
+      num_regs = 0;
+
+      Compiler compiler{*this, layout, preserved, equation};
+      compiler.CompileExpr(0, 0);
+      compiler.SkipSpace();
+      is_compiled = compiler.ok && compiler.pos == equation.size() && code.size();
+      return is_compiled;
+    }
+
+    bool IsCompiled() const { return is_compiled; }
+    size_t GetNumInsts() const { return code.size(); }
+    size_t GetNumRegs() const { return num_regs; }
+
+    /// Evaluate the equation for a single DataMap.
+    double Run(const emp::DataMap & dm) const {
+      emp_assert(is_compiled);
+      double regs[MAX_REGS];
+      for (const Inst & inst : code) {
+        double * dest = regs + inst.dest;
+        if (inst.op == Op::CONST) *dest = constants[inst.index];
+        else if (inst.op == Op::LOAD) *dest = ReadTrait(dm, loads[inst.index]);
+        else Apply(inst.op, dest, regs + inst.arg1, regs + inst.arg2, 1);
+      }
+      return regs[0];
+    }
+
+    /// Evaluate the equation for 'count' DataMaps, where get_dm(i) returns the i'th; results
+    /// are placed in out[0] through out[count-1].
+    template <typename GET_DM_T>
+    void RunBatch(size_t count, GET_DM_T get_dm, double * out) const {
+      emp_assert(is_compiled);
+      thread_local emp::vector<double> lanes;
+      lanes.resize(num_regs * BATCH_SIZE);
+
+      for (size_t start = 0; start < count; start += BATCH_SIZE) {
+        const size_t batch_count = std::min(BATCH_SIZE, count - start);
+        for (const Inst & inst : code) {
+          double * dest = lanes.data() + inst.dest * BATCH_SIZE;
+          if (inst.op == Op::CONST) {
+            std::fill(dest, dest + batch_count, constants[inst.index]);
+          }
+          else if (inst.op == Op::LOAD) {
+            const Load & load = loads[inst.index];
+            for (size_t i = 0; i < batch_count; ++i) dest[i] = ReadTrait(get_dm(start + i), load);
+          }
+          else {
+            Apply(inst.op, dest, lanes.data() + inst.arg1 * BATCH_SIZE,
+                  lanes.data() + inst.arg2 * BATCH_SIZE, batch_count);
+          }
+        }
+        std::copy(lanes.data(), lanes.data() + batch_count, out + start);
+      }
+    }
+  };
+
+}
+
+#endif
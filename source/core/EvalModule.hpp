@@ -32,7 +32,10 @@ namespace mabe {
     // Setup member functions associated with this class.
     static void InitType(emplode::TypeInfo & info) {
       info.AddMemberFunction("EVAL",
-                             [](DERIVED_T & mod, Collection list) { return mod.Evaluate(list); },
+                             [](DERIVED_T & mod, Collection list) {
+                               auto timer = mod.Profile("EVAL");
+                               return mod.Evaluate(list);
+                             },
                              "Evaluate all orgs in the OrgList.");
       info.AddMemberFunction("RESET",
                              [](DERIVED_T & mod) { return mod.Reset(); },
@@ -0,0 +1,141 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  HashCounts.hpp
+ *  @brief Count distinct values (such as genomes) by 64-bit content hash.
+ *
+ *  Finding the mode, richness, or entropy of a string trait does not require a copy of every
+ *  string; it is enough to count how often each content hash appears and to remember where one
+ *  example of each hash can be found.  Only the winning value ever needs to be materialized.
+ *
+ *  ContentHash() is deterministic across runs and platforms (for a given byte order), so ties
+ *  (broken in favor of the smallest hash) are resolved the same way everywhere.  Distinct values
+ *  with the same 64-bit hash would be counted together; for realistic population sizes the
+ *  chance of this is negligible.
+ */
+
+#ifndef MABE_HASH_COUNTS_H
+#define MABE_HASH_COUNTS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+namespace mabe {
+
+  /// Hash the contents of a string, eight bytes at a time.  Never returns 0, so that 0 can
+  /// mark a missing value.
+  inline uint64_t ContentHash(std::string_view data) {
+    constexpr uint64_t MULT = 0x9E3779B97F4A7C15ull;
+    uint64_t hash = 0x6A09E667F3BCC909ull ^ (data.size() * MULT);
+    size_t pos = 0;
+    for (; pos + 8 <= data.size(); pos += 8) {
+      uint64_t word;
+      std::memcpy(&word, data.data() + pos, 8);
+      hash = (hash ^ word) * MULT;
+      hash ^= hash >> 29;
+    }
+    if (pos < data.size()) {
+      uint64_t word = 0;
+      std::memcpy(&word, data.data() + pos, data.size() - pos);
+      hash = (hash ^ word) * MULT;
+      hash ^= hash >> 29;
+    }
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return hash ? hash : 1;
+  }
+
+  class HashCounts {
+  public:
+    static constexpr size_t NO_POS = (size_t) -1;
+
+  private:
+    struct Group {
+      size_t count = 0;     ///< Number of values with this hash.
+      size_t pos = NO_POS;  ///< Position of one such value (NO_POS if it needs to be found).
+    };
+
+    std::unordered_map<uint64_t, Group> groups;
+    size_t total = 0;
+
+  public:
+    size_t GetTotal() const { return total; }
+
+    /// Number of distinct hashes.
+    size_t GetRichness() const { return groups.size(); }
+
+    /// Record a value with the given hash found at pos.
+    void Add(uint64_t hash, size_t pos) {
+      Group & group = groups[hash];
+      if (group.count++ == 0) group.pos = pos;
+      ++total;
+    }
+
+    /// Remove a value with the given hash that was at pos.
+    void Remove(uint64_t hash, size_t pos) {
+      auto it = groups.find(hash);
+      emp_assert(it != groups.end() && it->second.count > 0);
+      --total;
+      if (--it->second.count == 0) groups.erase(it);
+      else if (it->second.pos == pos) it->second.pos = NO_POS;
+    }
+
+    /// Most common hash (ties go to the smallest hash); 0 if there are no values.
+    uint64_t GetModeHash() const {
+      uint64_t best_hash = 0;
+      size_t best_count = 0;
+      for (const auto & [hash, group] : groups) {
+        if (group.count > best_count || (group.count == best_count && hash < best_hash)) {
+          best_hash = hash;
+          best_count = group.count;
+        }
+      }
+      return best_hash;
+    }
+
+    /// Position of a value with the given hash, or NO_POS if it was removed.
+    size_t GetPos(uint64_t hash) const {
+      auto it = groups.find(hash);
+      return it == groups.end() ? NO_POS : it->second.pos;
+    }
+
+    /// Record where a value with the given hash can be found.
+    void SetPos(uint64_t hash, size_t pos) {
+      auto it = groups.find(hash);
+      emp_assert(it != groups.end());
+      it->second.pos = pos;
+    }
+
+    /// Shannon entropy (in bits); terms are added in order of hash, for reproducibility.
+    double GetEntropy() const {
+      emp::vector<std::pair<uint64_t, size_t>> sorted;
+      sorted.reserve(groups.size());
+      for (const auto & [hash, group] : groups) sorted.emplace_back(hash, group.count);
+      std::sort(sorted.begin(), sorted.end());
+
+      const double N = (double) total;
+      double entropy = 0.0;
+      for (const auto & [hash, count] : sorted) {
+        const double p = ((double) count) / N;
+        entropy -= p * std::log2(p);
+      }
+      return entropy;
+    }
+
+    void Clear() { groups.clear(); total = 0; }
+  };
+
+}
+
+#endif
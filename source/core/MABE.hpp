@@ -16,9 +16,14 @@
 #ifndef MABE_MABE_HPP
 #define MABE_MABE_HPP
 
+#include <cstddef>
+#include <fstream>
 #include <limits>
 #include <string>
 #include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 
 #include "emp/base/array.hpp"
 #include "emp/base/Ptr.hpp"
@@ -42,6 +47,7 @@
 #include "MABEScript.hpp"
 #include "ModuleBase.hpp"
 #include "Population.hpp"
+#include "Serialize.hpp"
 #include "SigListener.hpp"
 #include "TraitManager.hpp"
 #include "ActionMap.hpp"
@@ -97,6 +103,7 @@ namespace mabe {
     emp::vector<std::string> config_filenames; ///< Names of configuration files to load.
     emp::vector<std::string> config_settings;  ///< Additional config commands to run.
     std::string gen_filename;                  ///< Name of output file to generate.
+    std::string restore_filename;              ///< Checkpoint file to resume from (if any).
     MABEScript config_script;                  ///< Configuration information for this run.
     
     // ----------- Helper Functions -----------    
@@ -109,6 +116,12 @@ namespace mabe {
     void Setup_Modules();     ///< Run SetupModule() method on each module we've loaded.
     void UpdateSignals();     ///< Link signals only to modules that respond to them.
 
+    /// Shared implementation for DoBirths(); next_parent(ppos, count) fills in the next parent
+    /// and how many offspring it should produce, returning false once there are no more.
+    template <typename NEXT_T>
+    Collection DoBirths_impl(NEXT_T && next_parent, Population & target_pop,
+                             bool place_before_choosing, bool do_mutations);
+
   public:
     MABE();                        ///< MABE default constructor (for testing)
     MABE(int argc, char* argv[]);  ///< MABE command-line constructor.
@@ -116,6 +129,7 @@ namespace mabe {
     MABE(MABE &&) = delete;
     ~MABE() {
       before_exit_sig.Trigger();                      // Notify modules of end...
+      if (profiler.IsActive()) profiler.WriteCSV();   // Save profiling results, if collected.
 
       for (auto pop_ptr : pops) {                     // Delete all populations.
         ClearPop(*pop_ptr);
@@ -224,6 +238,34 @@ namespace mabe {
                        OrgPosition target_pos,
                        bool do_mutations=true);
 
+    /// Give birth to offspring from many parents at once; each entry in 'parents' is a parent
+    /// position and the number of offspring it should produce.  Results match calling DoBirth()
+    /// on each parent in order, but placements are grouped so that batch signals trigger once
+    /// per group.  Return all offspring placed.
+    Collection DoBirths(const emp::vector<std::pair<OrgPosition,size_t>> & parents,
+                        Population & target_pop,
+                        bool do_mutations=true);
+
+    /// Give birth to num_births offspring, each from the parent position returned by
+    /// choose_parent().  The parent is chosen right before its birth, so random draws happen
+    /// in the same order as choosing and replicating each parent in turn.  If choose_parent()
+    /// looks at organisms in target_pop, set place_before_choosing so that all earlier
+    /// offspring are in place when it does (at the cost of batching).  Return all offspring placed.
+    template <typename CHOOSE_T>
+    Collection DoBirths(size_t num_births,
+                        CHOOSE_T && choose_parent,
+                        Population & target_pop,
+                        bool place_before_choosing,
+                        bool do_mutations=true) {
+      size_t birth_id = 0;
+      return DoBirths_impl([&](OrgPosition & ppos, size_t & count){
+        if (birth_id++ == num_births) return false;
+        ppos = choose_parent();
+        count = 1;
+        return true;
+      }, target_pop, place_before_choosing, do_mutations);
+    }
+
 
     /// A shortcut to DoBirth where only the parent position needs to be supplied;
     /// Return all offspring placed.
@@ -255,6 +297,13 @@ namespace mabe {
     /// Move all organisms from one population to another.
     void MoveOrgs(Population & from_pop, Population & to_pop, bool reset_to) override;
 
+    /// Save the full state of this run (random number generator, update, all organisms with
+    /// their traits, and module state) to a binary checkpoint file.
+    void SaveCheckpoint(const std::string & filename) override;
+
+    /// Restore a run from a checkpoint file; configuration must match the saved run.
+    bool LoadCheckpoint(const std::string & filename);
+
     /// Return a random position from a designated population.
     OrgPosition GetRandomPos(Population & pop) {
       emp_assert(pop.GetSize() > 0);
@@ -316,8 +365,16 @@ namespace mabe {
     /// Resets ALL traits for a given organism to their default values
     void ResetTraits(Organism& org){
       trait_man.ResetAll(org.GetDataMap());
+      org.NoteTraitWrite();  // Written through the DataMap, so trait trackers must be told.
+    }
+
+    emp::Ptr<const TraitInfo> GetTraitInfo(const std::string & trait_name) const override {
+      return trait_man.GetTraitInfo(trait_name);
     }
 
+    /// Print the number of bytes used per organism by each trait.
+    void PrintTraitStorage() const override { trait_man.PrintStorageReport(std::cout); }
+
     /// Return the DataMap for organisms
     emp::DataMap GetOrganismDataMap(){
       return org_data_map;
@@ -337,6 +394,13 @@ namespace mabe {
       return BuildTraitEquation(pop.GetDataLayout(), equation);
     }
 
+    /// Build a function that calculates an equation for every organism in a group at once.
+    template <typename GROUP_T=Collection>
+    auto BuildTraitEquationBatch(const emp::DataLayout & data_layout, const std::string & equation)
+    {
+      return config_script.BuildTraitEquationBatch<GROUP_T>(data_layout, equation);
+    }
+
     const std::set<std::string> & GetEquationTraits(const std::string & equation) {
       return config_script.GetEquationTraits(equation);
     }
@@ -361,6 +425,8 @@ namespace mabe {
     bool OnInjectReady_IsTriggered(mod_ptr_t mod) { return on_inject_ready_sig.cur_mod == mod; };
     bool BeforePlacement_IsTriggered(mod_ptr_t mod) { return before_placement_sig.cur_mod == mod; };
     bool OnPlacement_IsTriggered(mod_ptr_t mod) { return on_placement_sig.cur_mod == mod; };
+    bool BeforePlacementBatch_IsTriggered(mod_ptr_t mod) { return before_placement_batch_sig.cur_mod == mod; };
+    bool OnPlacementBatch_IsTriggered(mod_ptr_t mod) { return on_placement_batch_sig.cur_mod == mod; };
     bool BeforeMutate_IsTriggered(mod_ptr_t mod) { return before_mutate_sig.cur_mod == mod; };
     bool OnMutate_IsTriggered(mod_ptr_t mod) { return on_mutate_sig.cur_mod == mod; };
     bool BeforeDeath_IsTriggered(mod_ptr_t mod) { return before_death_sig.cur_mod == mod; };
@@ -368,6 +434,7 @@ namespace mabe {
     bool OnSwap_IsTriggered(mod_ptr_t mod) { return on_swap_sig.cur_mod == mod; };
     bool BeforePopResize_IsTriggered(mod_ptr_t mod) { return before_pop_resize_sig.cur_mod == mod; };
     bool OnPopResize_IsTriggered(mod_ptr_t mod) { return on_pop_resize_sig.cur_mod == mod; };
+    bool OnPopReplace_IsTriggered(mod_ptr_t mod) { return on_pop_replace_sig.cur_mod == mod; };
     bool BeforeExit_IsTriggered(mod_ptr_t mod) { return before_exit_sig.cur_mod == mod; };
     bool OnHelp_IsTriggered(mod_ptr_t mod) { return on_help_sig.cur_mod == mod; };
   };
@@ -478,6 +545,23 @@ namespace mabe {
       });
     arg_set.emplace_back("--modules", "-m", "              ", "Module list",
       [this](const emp::vector<std::string> &){ ShowModules(); } );
+    arg_set.emplace_back("--profile", "-p", "[filename]    ", "Time signals and script calls; save as CSV",
+      [this](const emp::vector<std::string> & in){
+        if (in.size() > 1) {
+          std::cout << "'--profile' may be followed by at most one filename.\n";
+          exit_now = true;
+          return;
+        }
+        if (in.size()) profiler.SetFilename(in[0]);
+        SetProfiling(true);
+      });
+    arg_set.emplace_back("--restore", "-r", "[filename]    ", "Resume a run from a checkpoint file",
+      [this](const emp::vector<std::string> & in){
+        if (in.size() != 1) {
+          std::cout << "'--restore' must be followed by a single filename.\n";
+          exit_now = true;
+        } else restore_filename = in[0];
+      });
     arg_set.emplace_back("--set", "-s", "[param=value] ", "Set specified parameter",
       [this](const emp::vector<std::string> & in){
         std::cout << "Adding command-line setting:";
@@ -486,6 +570,13 @@ namespace mabe {
         emp::Append(config_settings, in);
         config_settings.push_back(";"); // Extra semi-colon so not needed on command line.
       });
+    arg_set.emplace_back("--threads", "-t", "[count]       ", "Number of threads to use (0 for all cores)",
+      [this](const emp::vector<std::string> & in){
+        if (in.size() != 1) {
+          std::cout << "'--threads' must be followed by a single thread count.\n";
+          exit_now = true;
+        } else SetNumThreads(emp::from_string<size_t>(in[0]));
+      });
     arg_set.emplace_back("--version", "-v", "              ", "Version ID of MABE",
       [this](const emp::vector<std::string> &){
         std::cout << "MABE v" << VERSION << "\n";
@@ -567,8 +658,19 @@ namespace mabe {
     Verbose("Analyzing configuration of ", trait_man.GetSize(), " traits.");
 
     trait_man.Verify(verbose);            // Make sure modules are accessing traits consistently
+
+    // Mark any traits the user requested compact storage for.
+    for (std::string name : emp::slice(compact_traits, ',')) {
+      emp::remove_whitespace(name);
+      if (name.size() && !trait_man.SetCompact(name)) {
+        emp::notify::Warning("Unknown trait '", name, "' in compact_traits; ignoring.");
+      }
+    }
+
     trait_man.RegisterAll(org_data_map);  // Load in all of the traits to the DataMap
     org_data_map.LockLayout();            // Freeze the data map into its current state
+    trait_man.BuildResetImage(org_data_map); // Precompute how to reset traits to defaults
+    if (verbose) trait_man.PrintStorageReport(std::cout);
 
     // Alert modules (especially org managers) to the final set of traits.
     for (emp::Ptr<ModuleBase> mod_ptr : modules) {
@@ -588,6 +690,15 @@ namespace mabe {
       for (size_t sig_id = 0; sig_id < sig_ptrs.size(); sig_id++) {
         if (mod_ptr->has_signal[sig_id]) sig_ptrs[sig_id]->push_back(mod_ptr);
       }
+
+      // A module that handles placements in batches only hears the batch form of that signal,
+      // so that no placement is reported to it twice.
+      if (mod_ptr->has_signal[ModuleBase::SIG_BeforePlacementBatch]) {
+        std::erase(before_placement_sig, mod_ptr);
+      }
+      if (mod_ptr->has_signal[ModuleBase::SIG_OnPlacementBatch]) {
+        std::erase(on_placement_sig, mod_ptr);
+      }
     }
 
     // Now that we have scanned the signals, we can turn off the re-scan flag.
@@ -640,6 +751,9 @@ namespace mabe {
     UpdateSignals();    // Setup the appropriate modules to be linked with each signal.
     SetupBase();        // Call Setup on MABEBase (which will report errors)
 
+    // If we are resuming a previous run, load its state.
+    if (restore_filename.size() && !LoadCheckpoint(restore_filename)) return false;
+
     return true;
   }
 
@@ -655,6 +769,13 @@ namespace mabe {
       update++;                                 // Increment 'update' to start new update
       on_update_sig.Trigger(update);            // Signal all modules about the new update
       config_script.Trigger("UPDATE", update);  // Trigger any updated-based events
+#ifndef NDEBUG
+      // In debug mode, report any traits still being accessed by name (a hash lookup each).
+      if (verbose && TraitNameLookups::GetTotal()) {
+        std::cout << "Update " << update << " trait lookups by name:\n";
+        TraitNameLookups::Report(std::cout);
+      }
+#endif
     }
   }
 
@@ -807,7 +928,353 @@ namespace mabe {
     return target_pos;
   }
 
+  Collection MABE::DoBirths(const emp::vector<std::pair<OrgPosition,size_t>> & parents,
+                            Population & target_pop,
+                            bool do_mutations) {
+    size_t parent_id = 0;
+    return DoBirths_impl([&](OrgPosition & ppos, size_t & count){
+      if (parent_id == parents.size()) return false;
+      ppos = parents[parent_id].first;
+      count = parents[parent_id++].second;
+      return true;
+    }, target_pop, false, do_mutations);
+  }
+
+  template <typename NEXT_T>
+  Collection MABE::DoBirths_impl(NEXT_T && next_parent, Population & target_pop,
+                                 bool place_before_choosing, bool do_mutations) {
+    // Offspring are built and placed in the same order (with the same random draws) as calling
+    // DoBirth() on each parent in turn, but placements are grouped into batches that cannot
+    // interact: no two offspring in a batch share a target, and no target holds the parent of
+    // another offspring in the batch.  A batch is placed as soon as the next birth would break
+    // this, or would use a parent that is about to be replaced.
+    emp::vector<emp::Ptr<Organism>> batch_orgs;
+    emp::vector<OrgPosition> batch_pos;
+    emp::vector<OrgPosition> batch_ppos;
+    emp::BitVector pending(target_pop.GetSize());   // Target positions in the current batch.
+    emp::BitVector pending_parents(target_pop.GetSize()); // Parents of orgs in current batch.
+    emp::BitVector placed(target_pop.GetSize());    // All positions that received offspring.
+    Collection birth_list;
+
+    // Placement may grow the population, so bit vectors are resized as needed.
+    auto has = [](const emp::BitVector & bits, size_t id){
+      return id < bits.GetSize() && bits.Has(id);
+    };
+    auto mark = [&target_pop](emp::BitVector & bits, size_t id){
+      if (bits.GetSize() <= id) bits.Resize(target_pop.GetSize());
+      bits.Set(id);
+    };
+    auto flush = [&](){
+      if (batch_orgs.size() == 0) return;
+      AddOrgsAt(std::span<const emp::Ptr<Organism>>(batch_orgs.data(), batch_orgs.size()),
+                std::span<const OrgPosition>(batch_pos.data(), batch_pos.size()),
+                std::span<const OrgPosition>(batch_ppos.data(), batch_ppos.size()));
+      batch_orgs.resize(0);
+      batch_pos.resize(0);
+      batch_ppos.resize(0);
+      pending.Clear();
+      pending_parents.Clear();
+    };
+
+    OrgPosition ppos;
+    size_t birth_count = 0;
+    while (true) {
+      if (place_before_choosing) flush();
+      if (!next_parent(ppos, birth_count)) break;
+      for (size_t i = 0; i < birth_count; i++) {
+        // If an offspring is about to replace this parent, place it before reproducing.
+        if (ppos.IsInPop(target_pop) && has(pending, ppos.Pos())) flush();
+        if (i == 0) before_repro_sig.Trigger(ppos);    // Signal reproduction event (once).
+
+        const Organism & org = *ppos;
+        emp_assert(org.IsEmpty() == false);             // Empty cells cannot reproduce.
+        emp::Ptr<Organism> new_org =
+          do_mutations ? org.MakeOffspringOrganism(random) : org.CloneOrganism();
+        on_offspring_ready_sig.Trigger(*new_org, ppos, target_pop);
+        OrgPosition pos = target_pop.PlaceBirth(*new_org, ppos);
+
+        // If this placement is not valid, delete the organism.
+        if (!pos.IsValid()) { new_org.Delete(); continue; }
+
+        // Births into other populations are placed individually.
+        if (!pos.IsInPop(target_pop)) {
+          flush();
+          AddOrgAt(new_org, pos, ppos);
+          birth_list.Insert(pos);
+          continue;
+        }
+
+        // A target that already has a pending offspring (which this one should overwrite) or
+        // that holds the parent of a pending offspring must wait for the current batch.
+        if (has(pending, pos.Pos()) || has(pending_parents, pos.Pos())) flush();
+        mark(pending, pos.Pos());
+        mark(placed, pos.Pos());
+        if (ppos.IsInPop(target_pop)) mark(pending_parents, ppos.Pos());
+        batch_orgs.push_back(new_org);
+        batch_pos.push_back(pos);
+        batch_ppos.push_back(ppos);
+      }
+    }
+    flush();
+
+    birth_list.InsertPositions(target_pop, placed);
+    return birth_list;
+  }
+
+  // Checkpoint format (all values in native byte order):
+  //   Header:  "MABECKPT", format version, update, parallel loop count, random generator state
+  //            (raw bytes, or a fresh seed that the generator was restarted from)
+  //   Traits:  name, type name, and raw byte size (0 if streamed) of each serializable trait
+  //   Types:   names of all organism managers used
+  //   Pops:    name, size, and living organism count; then for each organism its position,
+  //            manager ID, manager-specific state, one raw block with all fixed-size traits,
+  //            and then all variable-size traits in order.
+  //   Modules: name, whether its state was saved, and size-prefixed state blob for each module.
+  static constexpr const char * CHECKPOINT_MAGIC = "MABECKPT";
+  static constexpr uint32_t CHECKPOINT_VERSION = 2;
+
+  void MABE::SaveCheckpoint(const std::string & filename) {
+    std::ofstream os(filename, std::ios::binary);
+    if (!os) {
+      emp::notify::Error("Unable to open checkpoint file '", filename, "' for writing.");
+      return;
+    }
+    Verbose("Saving checkpoint to '", filename, "' at update ", update, ".");
+
+    // --- Header ---
+    os.write(CHECKPOINT_MAGIC, 8);
+    BinaryWrite(os, CHECKPOINT_VERSION);
+    BinaryWrite<uint64_t>(os, update);
+    BinaryWrite<uint64_t>(os, parallel_count);
+    if constexpr (std::is_trivially_copyable<emp::Random>()) {
+      BinaryWrite<uint64_t>(os, sizeof(emp::Random));
+      os.write(reinterpret_cast<const char *>(&random), sizeof(emp::Random));
+    } else {
+      // The generator's internal state cannot be copied out, so restart it from a seed drawn
+      // from it.  This run and any run restored from this checkpoint then continue with the
+      // same random sequence.
+      const int next_seed = (int) random.GetUInt(1, std::numeric_limits<int>::max());
+      random.ResetSeed(next_seed);
+      BinaryWrite<uint64_t>(os, 0);
+      BinaryWrite<int64_t>(os, next_seed);
+    }
+
+    // --- Trait layout: raw traits are packed into one block per organism ---
+    struct TraitPlan { emp::Ptr<TraitInfo> info; size_t id; size_t offset; };
+    emp::vector<TraitPlan> raw_traits, stream_traits;
+    size_t raw_size = 0;
+    emp::vector<emp::Ptr<TraitInfo>> traits;
+    for (emp::Ptr<TraitInfo> trait : trait_man.GetTraits()) {
+      if (!org_data_map.HasName(trait->GetName())) continue;
+      if (!trait->IsSerializable()) {
+        Verbose("Trait '", trait->GetName(), "' cannot be saved; it will be reset on restore.");
+        continue;
+      }
+      const size_t id = org_data_map.GetID(trait->GetName());
+      if (trait->IsRawSerializable()) {
+        raw_traits.push_back(TraitPlan{trait, id, raw_size});
+        raw_size += trait->GetRawSize();
+      }
+      else stream_traits.push_back(TraitPlan{trait, id, 0});
+    }
+    auto write_plan = [&os](const TraitPlan & plan) {
+      BinaryWrite(os, plan.info->GetName());
+      BinaryWrite(os, plan.info->GetType().GetName());
+      BinaryWrite<uint64_t>(os, plan.info->GetRawSize());
+    };
+    BinaryWrite<uint64_t>(os, raw_traits.size() + stream_traits.size());
+    for (const TraitPlan & plan : raw_traits) write_plan(plan);
+    for (const TraitPlan & plan : stream_traits) write_plan(plan);
+
+    // --- Organism types ---
+    emp::vector<std::string> type_names;
+    std::unordered_map<std::string, uint32_t> type_ids;
+    for (emp::Ptr<Population> pop_ptr : pops) {
+      for (size_t pos : pop_ptr->GetLivingPositions()) {
+        const std::string & type_name = (*pop_ptr)[pos].GetManager().GetName();
+        if (type_ids.emplace(type_name, (uint32_t) type_names.size()).second) {
+          type_names.push_back(type_name);
+        }
+      }
+    }
+    BinaryWrite(os, type_names);
+
+    // --- Populations ---
+    emp::vector<std::byte> raw_block(raw_size);
+    BinaryWrite<uint64_t>(os, pops.size());
+    for (emp::Ptr<Population> pop_ptr : pops) {
+      Population & pop = *pop_ptr;
+      BinaryWrite(os, pop.GetName());
+      BinaryWrite<uint64_t>(os, pop.GetSize());
+      BinaryWrite<uint64_t>(os, pop.GetNumOrgs());
+      for (size_t pos = 0; pos < pop.GetSize(); ++pos) {  // Save in position order.
+        if (pop.IsEmpty(pos)) continue;
+        const Organism & org = pop[pos];
+        BinaryWrite<uint64_t>(os, pos);
+        BinaryWrite<uint32_t>(os, type_ids[org.GetManager().GetName()]);
+        if (!org.SaveState(os)) {
+          emp::notify::Error("Organism type '", org.GetManager().GetName(),
+                             "' does not support checkpointing.");
+          return;
+        }
+        org.SyncTraits();
+        const emp::DataMap & dm = org.GetDataMap();
+        for (const TraitPlan & plan : raw_traits) {
+          plan.info->CopyToRaw(dm, plan.id, raw_block.data() + plan.offset);
+        }
+        os.write(reinterpret_cast<const char *>(raw_block.data()), (std::streamsize) raw_size);
+        for (const TraitPlan & plan : stream_traits) plan.info->SaveValue(os, dm, plan.id);
+      }
+    }
+
+    // --- Modules ---
+    BinaryWrite<uint64_t>(os, modules.size());
+    for (emp::Ptr<ModuleBase> mod_ptr : modules) {
+      std::stringstream mod_state;
+      const bool saved = mod_ptr->SaveState(mod_state);
+      if (!saved) {
+        emp::notify::Warning("Module '", mod_ptr->GetName(), "' cannot save its state; ",
+                             "it will restart from scratch if this checkpoint is restored.");
+      }
+      BinaryWrite(os, mod_ptr->GetName());
+      BinaryWrite<uint8_t>(os, saved);
+      BinaryWrite(os, mod_state.str());
+    }
+
+    if (!os) emp::notify::Error("Failed while writing checkpoint file '", filename, "'.");
+  }
+
+  bool MABE::LoadCheckpoint(const std::string & filename) {
+    std::ifstream is(filename, std::ios::binary);
+    if (!is) {
+      emp::notify::Error("Unable to open checkpoint file '", filename, "'.");
+      return false;
+    }
+    Verbose("Restoring checkpoint from '", filename, "'.");
+
+    auto fail = [&filename](auto &&... msg) {
+      emp::notify::Error("Checkpoint '", filename, "': ", msg...);
+      return false;
+    };
+
+    // --- Header ---
+    char magic[8];
+    is.read(magic, 8);
+    if (!is || std::string(magic, 8) != CHECKPOINT_MAGIC) return fail("not a MABE checkpoint.");
+    if (BinaryRead<uint32_t>(is) != CHECKPOINT_VERSION) return fail("unsupported version.");
+    const size_t saved_update = BinaryRead<uint64_t>(is);
+    parallel_count = BinaryRead<uint64_t>(is);
+    const uint64_t random_size = BinaryRead<uint64_t>(is);
+    if constexpr (std::is_trivially_copyable<emp::Random>()) {
+      if (random_size == sizeof(emp::Random)) {
+        is.read(reinterpret_cast<char *>(&random), sizeof(emp::Random));
+      } else if (random_size == 0) {
+        random.ResetSeed((int) BinaryRead<int64_t>(is));
+      } else return fail("random number generator state does not match this build.");
+    } else {
+      if (random_size != 0) return fail("random number generator state does not match this build.");
+      random.ResetSeed((int) BinaryRead<int64_t>(is));
+    }
+
+    // --- Trait layout ---
+    struct TraitPlan { emp::Ptr<TraitInfo> info; size_t id; size_t offset; };
+    emp::vector<TraitPlan> raw_traits, stream_traits;
+    size_t raw_size = 0;
+    const size_t num_traits = BinaryRead<uint64_t>(is);
+    for (size_t i = 0; i < num_traits; ++i) {
+      const std::string name = BinaryRead<std::string>(is);
+      const std::string type_name = BinaryRead<std::string>(is);
+      const size_t trait_size = BinaryRead<uint64_t>(is);
+      emp::Ptr<TraitInfo> trait = trait_man.GetTraitInfo(name);
+      if (!trait || !org_data_map.HasName(name)) return fail("unknown trait '", name, "'.");
+      if (trait->GetType().GetName() != type_name || trait->GetRawSize() != trait_size) {
+        return fail("trait '", name, "' has changed type or size.");
+      }
+      const size_t id = org_data_map.GetID(name);
+      if (trait_size) {
+        raw_traits.push_back(TraitPlan{trait, id, raw_size});
+        raw_size += trait_size;
+      }
+      else stream_traits.push_back(TraitPlan{trait, id, 0});
+    }
+
+    // --- Organism types ---
+    const emp::vector<std::string> type_names = BinaryRead<emp::vector<std::string>>(is);
+    emp::vector<emp::Ptr<ModuleBase>> type_managers;
+    for (const std::string & type_name : type_names) {
+      const int mod_id = GetModuleID(type_name);
+      if (mod_id < 0) return fail("unknown organism type '", type_name, "'.");
+      type_managers.push_back(&GetModule(mod_id));
+    }
+
+    // --- Populations ---
+    emp::vector<std::byte> raw_block(raw_size);
+    const size_t num_pops = BinaryRead<uint64_t>(is);
+    for (size_t pop_id = 0; pop_id < num_pops; ++pop_id) {
+      const std::string pop_name = BinaryRead<std::string>(is);
+      const size_t pop_size = BinaryRead<uint64_t>(is);
+      const size_t num_orgs = BinaryRead<uint64_t>(is);
+      if (!is) return fail("file is truncated.");
+      const int cur_pop_id = GetPopID(pop_name);
+      if (cur_pop_id < 0) return fail("unknown population '", pop_name, "'.");
+      Population & pop = GetPopulation(cur_pop_id);
+      EmptyPop(pop, pop_size);
+
+      for (size_t org_id = 0; org_id < num_orgs; ++org_id) {
+        const size_t pos = BinaryRead<uint64_t>(is);
+        const size_t type_id = BinaryRead<uint32_t>(is);
+        if (!is || pos >= pop_size || type_id >= type_managers.size()) {
+          return fail("invalid organism entry in population '", pop_name, "'.");
+        }
+        emp::Ptr<Organism> org_ptr = type_managers[type_id]->Make<Organism>();
+        if (!org_ptr->LoadState(is)) {
+          org_ptr.Delete();
+          return fail("unable to load organism of type '", type_names[type_id], "'.");
+        }
+        emp::DataMap & dm = org_ptr->GetDataMap();
+        is.read(reinterpret_cast<char *>(raw_block.data()), (std::streamsize) raw_size);
+        for (const TraitPlan & plan : raw_traits) {
+          plan.info->CopyFromRaw(dm, plan.id, raw_block.data() + plan.offset);
+        }
+        for (const TraitPlan & plan : stream_traits) plan.info->LoadValue(is, dm, plan.id);
+        if (!is) {
+          org_ptr.Delete();
+          return fail("file is truncated.");
+        }
+        AddOrgAt(org_ptr, OrgPosition(pop, pos));
+      }
+    }
+
+    // --- Modules ---
+    const size_t num_modules = BinaryRead<uint64_t>(is);
+    for (size_t i = 0; i < num_modules; ++i) {
+      const std::string mod_name = BinaryRead<std::string>(is);
+      const bool saved = BinaryRead<uint8_t>(is);
+      std::stringstream mod_state(BinaryRead<std::string>(is));
+      const int mod_id = GetModuleID(mod_name);
+      if (mod_id < 0) return fail("unknown module '", mod_name, "'.");
+      if (!saved) {
+        emp::notify::Warning("Checkpoint '", filename, "' does not include the state of module '",
+                             mod_name, "'; it restarts from scratch.");
+        continue;
+      }
+      if (!GetModule(mod_id).LoadState(mod_state)) {
+        return fail("unable to load state for module '", mod_name, "'.");
+      }
+    }
+    if (!is) return fail("file is truncated.");
+
+    update = saved_update;
+    return true;
+  }
+
   void MABE::MoveOrgs(Population & from_pop, Population & to_pop, bool reset_to) {
+    // Replacing one population with another can be done in bulk.
+    if (reset_to && &from_pop != &to_pop) {
+      ReplacePop(to_pop, from_pop);
+      return;
+    }
+
     // Get the starting point for the new organisms to ove to.
     Population::iterator_t it_to = reset_to ? to_pop.begin() : to_pop.end();
 
@@ -827,9 +1294,7 @@ namespace mabe {
   /// Return a random position from a designated population with a living organism in it.
   OrgPosition MABE::GetRandomOrgPos(Population & pop) {
     emp_assert(pop.GetNumOrgs() > 0, "GetRandomOrgPos cannot be called if there are no orgs.");
-    OrgPosition pos = GetRandomPos(pop);
-    while (pos.IsEmpty()) pos = GetRandomPos(pop);
-    return pos;
+    return pop.IteratorAt( pop.GetLivingPos(random.GetUInt(pop.GetNumOrgs())) );
   }
 
 
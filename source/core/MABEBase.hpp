@@ -10,16 +10,24 @@
 #ifndef MABE_MABE_BASE_H
 #define MABE_MABE_BASE_H
 
+#include <algorithm>
+#include <initializer_list>
+#include <span>
 #include <string>
 
 #include "emp/base/array.hpp"
 #include "emp/base/notify.hpp"
 #include "emp/base/Ptr.hpp"
 #include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
 
 #include "ModuleBase.hpp"
 #include "Population.hpp"
+#include "Profiler.hpp"
 #include "SigListener.hpp"
+#include "RandomStream.hpp"
+#include "ReduceKernels.hpp"
+#include "ThreadPool.hpp"
 
 namespace mabe {
 
@@ -34,6 +42,14 @@ namespace mabe {
     emp::Random random;      ///< Master random number generator
     size_t update = 0;       ///< How many times has Update() been called?
     bool verbose = false;    ///< Should we output extra information during setup?
+    std::string compact_traits = ""; ///< Traits to store compactly (comma-separated names).
+
+    // --- Parallel processing ---
+    ThreadPool thread_pool;  ///< Worker threads shared by all modules.
+    emp::vector<emp::Random> thread_random = emp::vector<emp::Random>(1); ///< RNG per thread.
+    size_t parallel_count = 0; ///< Number of parallel loops run so far (to vary random streams).
+
+    Profiler profiler;       ///< Timing information for signals and script calls (if active).
 
     /// Maintain a master array of pointers to all SigListeners.
     using sig_base_t = SigListenerBase<ModuleBase>;
@@ -58,6 +74,12 @@ namespace mabe {
     SigListener<ModuleBase,void,Organism &, OrgPosition, OrgPosition> before_placement_sig;
     // OnPlacement(OrgPosition placement_pos)
     SigListener<ModuleBase,void,OrgPosition> on_placement_sig;
+    // BeforePlacementBatch(span<const Ptr<Organism>> orgs, span<const OrgPosition> target_pos,
+    //                      span<const OrgPosition> parent_pos)
+    SigListener<ModuleBase,void,std::span<const emp::Ptr<Organism>>,
+                std::span<const OrgPosition>, std::span<const OrgPosition>> before_placement_batch_sig;
+    // OnPlacementBatch(span<const OrgPosition> placement_pos)
+    SigListener<ModuleBase,void,std::span<const OrgPosition>> on_placement_batch_sig;
     // BeforeMutate(Organism & org)
     SigListener<ModuleBase,void,Organism &> before_mutate_sig; // TO IMPLEMENT
     // OnMutate(Organism & org)
@@ -72,6 +94,8 @@ namespace mabe {
     SigListener<ModuleBase,void,Population &,size_t> before_pop_resize_sig;
     // OnPopResize(Population & pop, size_t old_size)
     SigListener<ModuleBase,void,Population &,size_t> on_pop_resize_sig;
+    // OnPopReplace(Population & to_pop, Population & from_pop)
+    SigListener<ModuleBase,void,Population &,Population &> on_pop_replace_sig;
     // BeforeExit()
     SigListener<ModuleBase,void> before_exit_sig;
     // OnHelp()
@@ -90,6 +114,8 @@ namespace mabe {
     , on_inject_ready_sig("on_inject_ready", ModuleBase::SIG_OnInjectReady, &ModuleBase::OnInjectReady, sig_ptrs)
     , before_placement_sig("before_placement", ModuleBase::SIG_BeforePlacement, &ModuleBase::BeforePlacement, sig_ptrs)
     , on_placement_sig("on_placement", ModuleBase::SIG_OnPlacement, &ModuleBase::OnPlacement, sig_ptrs)
+    , before_placement_batch_sig("before_placement_batch", ModuleBase::SIG_BeforePlacementBatch, &ModuleBase::BeforePlacementBatch, sig_ptrs)
+    , on_placement_batch_sig("on_placement_batch", ModuleBase::SIG_OnPlacementBatch, &ModuleBase::OnPlacementBatch, sig_ptrs)
     , before_mutate_sig("before_mutate", ModuleBase::SIG_BeforeMutate, &ModuleBase::BeforeMutate, sig_ptrs)
     , on_mutate_sig("on_mutate", ModuleBase::SIG_OnMutate, &ModuleBase::OnMutate, sig_ptrs)
     , before_death_sig("before_death", ModuleBase::SIG_BeforeDeath, &ModuleBase::BeforeDeath, sig_ptrs)
@@ -97,12 +123,20 @@ namespace mabe {
     , on_swap_sig("on_swap", ModuleBase::SIG_OnSwap, &ModuleBase::OnSwap, sig_ptrs)
     , before_pop_resize_sig("before_pop_resize", ModuleBase::SIG_BeforePopResize, &ModuleBase::BeforePopResize, sig_ptrs)
     , on_pop_resize_sig("on_pop_resize", ModuleBase::SIG_OnPopResize, &ModuleBase::OnPopResize, sig_ptrs)
+    , on_pop_replace_sig("on_pop_replace", ModuleBase::SIG_OnPopReplace, &ModuleBase::OnPopReplace, sig_ptrs)
     , before_exit_sig("before_exit", ModuleBase::SIG_BeforeExit, &ModuleBase::BeforeExit, sig_ptrs)
     , on_help_sig("on_help", ModuleBase::SIG_OnHelp, &ModuleBase::OnHelp, sig_ptrs)
-    { ;  }
+    {
+      Reduce::SetThreadPool(&thread_pool);  // Large numeric summaries may use worker threads.
+    }
+
+    /// Key for the random streams used by parallel loops (distinct from any module's streams).
+    static constexpr uint64_t PARALLEL_STREAM_KEY = RandomStream::HashName("MABE::ParallelFor");
 
   public:
-    virtual ~MABEBase() { }
+    virtual ~MABEBase() {
+      if (Reduce::ThreadPoolPtr() == &thread_pool) Reduce::SetThreadPool(nullptr);
+    }
 
     virtual void PrintAST() = 0;
 
@@ -112,8 +146,78 @@ namespace mabe {
 
     // --- Basic accessors ---
     emp::Random & GetRandom() { return random; }
+
+    /// Get a counter-based random stream determined only by the random seed and the provided
+    /// keys.  Streams share no state, so they are safe to use from any thread, and the same
+    /// keys reproduce the same draws regardless of thread count or evaluation order.
+    RandomStream GetRandomStream(std::initializer_list<uint64_t> keys) const {
+      return RandomStream( RandomStream::MixKeys((uint64_t) random.GetSeed(), keys) );
+    }
+
+    /// Get the random stream for a module in the current update; use GetSubstream() on the
+    /// result to derive independent streams (e.g., one per organism or per thread).
+    RandomStream GetRandomStream(const ModuleBase & mod, uint64_t stream_id=0) const {
+      return GetRandomStream({RandomStream::HashName(mod.GetName()), update, stream_id});
+    }
     size_t GetUpdate() const noexcept { return update; }
     bool GetVerbose() const { return verbose; }
+    const std::string & GetCompactTraits() const { return compact_traits; }
+    void SetCompactTraits(const std::string & in) { compact_traits = in; }
+
+    // --- Profiling ---
+    Profiler & GetProfiler() { return profiler; }
+
+    /// Turn profiling of all signals and instrumented script calls on or off.
+    void SetProfiling(bool active=true) {
+      profiler.SetActive(active);
+      for (emp::Ptr<sig_base_t> sig_ptr : sig_ptrs) {
+        sig_ptr->SetProfiler(active ? &profiler : nullptr);
+      }
+    }
+
+    /// Clear all profiling results collected so far.
+    void ResetProfiling() {
+      profiler.Reset();
+      SetProfiling(profiler.IsActive());  // Clear entries cached in signals.
+    }
+
+    // --- Parallel processing ---
+    ThreadPool & GetThreadPool() { return thread_pool; }
+    size_t GetNumThreads() const { return thread_pool.GetNumThreads(); }
+
+    /// Set the number of threads to use for parallel loops (0 = all hardware threads).
+    void SetNumThreads(size_t num_threads) {
+      thread_pool.SetNumThreads(num_threads);
+      thread_random.resize(thread_pool.GetNumThreads());
+    }
+
+    /// Run fun(id, random) for each id in [0, num_items), spread across all threads.  Each chunk
+    /// of work gets a random number generator seeded from its own RandomStream (keyed on the
+    /// master seed, the number of previous parallel loops, and the chunk ID), so results do not
+    /// depend on thread count.
+    /// Functions run in parallel and should only modify state associated with their own id.
+    /// If use_threads is false, chunks run in order on the calling thread (with the same
+    /// random number streams), for work that is not safe to run concurrently.
+    template <typename FUN_T>
+    void ParallelFor(size_t num_items, FUN_T && fun, size_t chunk_size=64,
+                     bool use_threads=true) {
+      const RandomStream loop_stream = GetRandomStream({PARALLEL_STREAM_KEY, parallel_count++});
+      if (!use_threads) {
+        emp::Random & chunk_random = thread_random[0];
+        for (size_t start = 0, chunk_id = 0; start < num_items; start += chunk_size, ++chunk_id) {
+          chunk_random.ResetSeed( loop_stream.GetSubstream(chunk_id).GetSeed() );
+          const size_t end = std::min(start + chunk_size, num_items);
+          for (size_t id = start; id < end; ++id) fun(id, chunk_random);
+        }
+        return;
+      }
+      thread_pool.ForEachChunk(num_items, chunk_size,
+        [this, &fun, loop_stream](size_t start, size_t end, size_t chunk_id, size_t thread_id){
+          emp::Random & chunk_random = thread_random[thread_id];
+          chunk_random.ResetSeed( loop_stream.GetSubstream(chunk_id).GetSeed() );
+          for (size_t id = start; id < end; ++id) fun(id, chunk_random);
+        });
+    }
 
     /// Trigger exit from run.
     void RequestExit() { exit_now = true; }
@@ -121,7 +225,9 @@ namespace mabe {
     /// Setup signals to be rescanned; call this if any signal is updated in a module.
     void RescanSignals() { rescan_signals = true; }
 
-    /// All insertions of organisms into a population should come through AddOrgAt
+    /// All insertions of organisms into a population should come through AddOrgAt.  Each
+    /// listening module hears either the single or the batch form of each placement signal,
+    /// never both (see MABE::UpdateSignals()); a form with no listeners costs only an empty check.
     /// @param[in] org_ptr points to the organism being added (which will now be owned by the population).
     /// @param[in] pos is the position to perform the insertion.
     /// @param[in] ppos is the parent position (required if it exists; not used with inject).
@@ -129,8 +235,41 @@ namespace mabe {
       emp_assert(org_ptr);                               // Must have a non-null organism to insert.
       ClearOrgAt(pos);                                   // Clear any organism already in this position.
       before_placement_sig.Trigger(*org_ptr, pos, ppos); // Notify listeners org is about to be placed.
+      before_placement_batch_sig.Trigger(std::span<const emp::Ptr<Organism>>(&org_ptr, 1),
+                                         std::span<const OrgPosition>(&pos, 1),
+                                         std::span<const OrgPosition>(&ppos, 1));
       pos.PopPtr()->SetOrg(pos.Pos(), org_ptr);          // Put the new organism in place.
       on_placement_sig.Trigger(pos);                     // Notify listeners org has been placed.
+      on_placement_batch_sig.Trigger(std::span<const OrgPosition>(&pos, 1));
+    }
+
+    /// Insert a group of organisms at once, triggering batch signals a single time.  Target
+    /// positions must all be distinct, and no target may hold the parent of a different
+    /// organism in the group, so the result matches calling AddOrgAt() on each in order.
+    /// @param[in] org_ptrs points to the organisms being added (which will now be owned by the populations).
+    /// @param[in] positions are the positions to perform the insertions.
+    /// @param[in] parent_positions are the parent positions (invalid positions for injections).
+    void AddOrgsAt(std::span<const emp::Ptr<Organism>> org_ptrs,
+                   std::span<const OrgPosition> positions,
+                   std::span<const OrgPosition> parent_positions) {
+      emp_assert(org_ptrs.size() == positions.size(), org_ptrs.size(), positions.size());
+      emp_assert(org_ptrs.size() == parent_positions.size());
+      const size_t count = org_ptrs.size();
+
+      // As with AddOrgAt(), each target is cleared before listeners hear about its new org.
+      for (size_t i = 0; i < count; ++i) {
+        ClearOrgAt(positions[i]);
+        before_placement_sig.Trigger(*org_ptrs[i], positions[i], parent_positions[i]);
+      }
+      before_placement_batch_sig.Trigger(org_ptrs, positions, parent_positions);
+
+      // Put all of the new organisms in place, and then notify listeners.
+      for (size_t i = 0; i < count; ++i) {
+        emp_assert(org_ptrs[i]);
+        positions[i].PopPtr()->SetOrg(positions[i].Pos(), org_ptrs[i]);
+      }
+      for (OrgPosition pos : positions) on_placement_sig.Trigger(pos);
+      on_placement_batch_sig.Trigger(positions);
     }
 
     /// All permanent deletion of organisms from a population should come through here.
@@ -142,7 +281,8 @@ namespace mabe {
       if (pos.IsEmpty()) return;                    // Already empty? Nothing to remove!
 
       before_death_sig.Trigger(pos);                // Send signal of current organism dying.
-      pos.Pop().ExtractOrg(pos.Pos()).Delete();     // Delete current organism.
+      emp::Ptr<Organism> org_ptr = pos.Pop().ExtractOrg(pos.Pos());
+      org_ptr->GetManager().RecycleObject(org_ptr); // Return org to its manager for reuse.
     }
 
     /// All movement of organisms from one population position to another should come through here.
@@ -175,6 +315,27 @@ namespace mabe {
       on_pop_resize_sig.Trigger(pop, old_size);             // Signal that resize has happened.
     }
 
+    /// Replace all organisms in to_pop with those from from_pop (keeping their positions), leaving
+    /// from_pop empty with size zero.  Organisms are moved in bulk, so instead of swap signals
+    /// for each organism, a single OnPopReplace signal is triggered once the move is complete.
+    void ReplacePop(Population & to_pop, Population & from_pop) {
+      emp_assert(&to_pop != &from_pop);
+
+      // Remove the current organisms from to_pop.
+      for (size_t pos = 0; pos < to_pop.GetSize(); pos++) ClearOrgAt( OrgPosition(to_pop, pos) );
+
+      const size_t to_size = to_pop.GetSize();
+      const size_t from_size = from_pop.GetSize();
+      if (to_size != from_size) before_pop_resize_sig.Trigger(to_pop, from_size);
+      if (from_size != 0) before_pop_resize_sig.Trigger(from_pop, 0);
+
+      to_pop.TakeOrgs(from_pop);                            // Do the actual move.
+
+      if (to_size != from_size) on_pop_resize_sig.Trigger(to_pop, to_size);
+      if (from_size != 0) on_pop_resize_sig.Trigger(from_pop, from_size);
+      on_pop_replace_sig.Trigger(to_pop, from_pop);
+    }
+
     /// Add a single, empty position onto the end of a population.
     PopIterator PushEmpty(Population & pop) {
       before_pop_resize_sig.Trigger(pop, pop.GetSize()+1);
@@ -189,6 +350,9 @@ namespace mabe {
     virtual Population & AddPopulation(const std::string & name, size_t pop_size=0) = 0;
     virtual void CopyPop(const Population & from_pop, Population & to_pop) = 0;
     virtual void MoveOrgs(Population & from_pop, Population & to_pop, bool reset_to) = 0;
+    virtual void SaveCheckpoint(const std::string & filename) = 0;
+    virtual emp::Ptr<const TraitInfo> GetTraitInfo(const std::string & trait_name) const = 0;
+    virtual void PrintTraitStorage() const = 0;
   };
 }
 
@@ -10,9 +10,14 @@
 #ifndef MABE_MABE_SCRIPT_HPP
 #define MABE_MABE_SCRIPT_HPP
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <string>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
 
 #include "emp/base/array.hpp"
 #include "emp/base/Ptr.hpp"
@@ -28,10 +33,12 @@
 
 #include "Collection.hpp"
 #include "data_collect.hpp"
+#include "EquationVM.hpp"
 #include "MABEBase.hpp"
 #include "ModuleBase.hpp"
 #include "Population.hpp"
 #include "SigListener.hpp"
+#include "SummaryPlanner.hpp"
 #include "TraitManager.hpp"
 
 namespace mabe {
@@ -48,15 +55,138 @@ namespace mabe {
     struct PreprocessResults {
       std::string result;             // Updated string
       emp::vector<emp::Datum> values; // Numerical values kept aside, if preserve_nums=true;
+
+      /// A string that identifies these results (including any preserved values).
+      std::string GetKey() const {
+        std::string key = result;
+        for (const emp::Datum & value : values) {
+          const double val = value.NativeDouble();
+          key.append(reinterpret_cast<const char *>(&val), sizeof(val));
+        }
+        return key;
+      }
+    };
+
+    // Compiled equations and summaries are cached so that scripts and modules that rebuild the
+    // same function every update do not reparse it.  Each entry is keyed on the data layout,
+    // the original (un-preprocessed) text, and the summary type; an entry is only rebuilt when
+    // the result of preprocessing (i.e., the value of any ${...}) changes.
+    using dm_fun_t = decltype( std::declval<emp::SimpleParser &>().BuildMathFunction(
+      std::declval<const emp::DataLayout &>(), std::declval<const std::string &>(),
+      std::declval<emp::vector<emp::Datum> &>() ) );
+
+    /// A compiled trait equation: bytecode (see EquationVM.hpp) if the equation is simple
+    /// enough, otherwise a function from the general parser.
+    struct TraitEquation {
+      EquationProgram program;
+      dm_fun_t dm_fun;
+
+      double operator()(const emp::DataMap & dm) const {
+        return program.IsCompiled() ? program.Run(dm) : dm_fun(dm);
+      }
+
+      /// Calculate the equation for 'count' DataMaps, where get_dm(i) returns the i'th.
+      template <typename GET_DM_T>
+      void RunBatch(size_t count, GET_DM_T get_dm, double * out) const {
+        if (program.IsCompiled()) program.RunBatch(count, get_dm, out);
+        else for (size_t i = 0; i < count; ++i) out[i] = dm_fun(get_dm(i));
+      }
     };
 
+    template <typename FUN_T>
+    struct CacheEntry {
+      bool is_built = false;  ///< Has a function been compiled yet?
+      std::string pp_key;     ///< Preprocessed text that this function was built from.
+      FUN_T fun;              ///< Compiled function.
+    };
+
+    template <typename FROM_T>
+    using summary_fun_t = std::function<Symbol_Var(const FROM_T &)>;
+
+    std::unordered_map<std::string, CacheEntry<TraitEquation>> equation_cache;
+    std::unordered_map<std::string, CacheEntry<summary_fun_t<Collection>>> collection_summary_cache;
+    std::unordered_map<std::string, CacheEntry<summary_fun_t<Population>>> pop_summary_cache;
+
+    /// Numeric population summaries are grouped by data layout, so that all summaries of a
+    /// population can be computed in a single pass (see SummaryPlanner.hpp); each planner
+    /// keeps separate results for every population with that layout.
+    std::unordered_map<const emp::DataLayout *, SummaryPlanner> summary_planners;
+
+    static std::string MakeCacheKey(const emp::DataLayout & data_layout,
+                                    const std::string & text,
+                                    const std::string & summary_type="") {
+      return std::to_string((uintptr_t) &data_layout) + ':' + summary_type + ':' + text;
+    }
+
+    template <typename FROM_T>
+    auto & GetSummaryCache() {
+      if constexpr (std::is_same<FROM_T,Population>()) return pop_summary_cache;
+      else return collection_summary_cache;
+    }
+
+    /// Compile an equation (or find it in the cache).
+    const TraitEquation & GetTraitEquation(const emp::DataLayout & data_layout,
+                                           const std::string & equation) {
+      auto pp_equ = Preprocess(equation, true);
+      std::string pp_key = pp_equ.GetKey();
+      CacheEntry<TraitEquation> & entry = equation_cache[MakeCacheKey(data_layout, equation)];
+      if (!entry.is_built || entry.pp_key != pp_key) {
+        emp::vector<double> preserved;
+        for (const emp::Datum & value : pp_equ.values) preserved.push_back(value.NativeDouble());
+        if (!entry.fun.program.Compile(data_layout, pp_equ.result, preserved)) {
+          entry.fun.dm_fun = dm_parser.BuildMathFunction(data_layout, pp_equ.result, pp_equ.values);
+        }
+        entry.pp_key = std::move(pp_key);
+        entry.is_built = true;
+      }
+      return entry.fun;
+    }
+
+    /// Make a function that runs an equation on every organism in a group, filling a vector
+    /// with the results (in the group's iteration order).
+    template <typename GROUP_T>
+    static auto MakeBatchFunction(const TraitEquation & equ) {
+      return [equ](const GROUP_T & group, emp::vector<double> & out) {
+        if constexpr (std::is_same<GROUP_T,Population>()) {
+          out.resize(group.GetSize());
+          equ.RunBatch(group.GetSize(),
+            [&group](size_t pos) -> const emp::DataMap & { return group[pos].GetDataMap(); },
+            out.data());
+        }
+        else {
+          thread_local emp::vector<emp::Ptr<const emp::DataMap>> dm_ptrs;
+          dm_ptrs.resize(0);
+          for (const Organism & org : group) dm_ptrs.push_back(&org.GetDataMap());
+          out.resize(dm_ptrs.size());
+          equ.RunBatch(dm_ptrs.size(),
+            [](size_t id) -> const emp::DataMap & { return *dm_ptrs[id]; }, out.data());
+        }
+      };
+    }
+
   public:
     /// Build a function to scan a data map, run a provided equation on its entries,
     /// and return the result.
     auto BuildTraitEquation(const emp::DataLayout & data_layout, std::string equation) {
-      auto pp_equ = Preprocess(equation, true);
-      auto dm_fun = dm_parser.BuildMathFunction(data_layout, pp_equ.result, pp_equ.values);
-      return [dm_fun](const Organism & org){ return dm_fun(org.GetDataMap()); };
+      const TraitEquation & equ = GetTraitEquation(data_layout, equation);
+      return [equ](const Organism & org){ return equ(org.GetDataMap()); };
+    }
+
+    /// Build a function that runs an equation on a whole group (Collection or Population) at
+    /// once, in the form:  void(const GROUP_T &, emp::vector<double> & results)
+    /// Results are in the group's iteration order; simple equations run as batched bytecode.
+    template <typename GROUP_T=Collection>
+    auto BuildTraitEquationBatch(const emp::DataLayout & data_layout, std::string equation) {
+      return MakeBatchFunction<GROUP_T>( GetTraitEquation(data_layout, equation) );
+    }
+
+    /// Remove all cached equations and summaries (they will be rebuilt as needed); previously
+    /// built summary functions must not be used afterward.
+    void ClearEquationCache() {
+      equation_cache.clear();
+      collection_summary_cache.clear();
+      pop_summary_cache.clear();
+      summary_planners.clear();
     }
 
     /// Scan an equation and return the names of all traits it is using.
@@ -123,28 +253,96 @@ namespace mabe {
     ///   max         : Return the largest value of this trait present.
     ///   ave         : Return the average value of this trait (alias="mean").
     ///   median      : Return the median value of this trait.
+    ///   p[NN]       : Return the NN'th percentile of this trait (e.g., "p90" or "p99.9").
+    ///   quantile[Q] : Return quantile Q (0.0 to 1.0) of this trait (e.g., "quantile0.99").
+    ///   [QUANTILE]~ : Estimate a median or quantile in constant memory ("median~", "p90~", or
+    ///                 "quantile~0.99"); faster on very large groups, with ~1% rank error.
     ///   variance    : Return the variance of this trait.
     ///   stddev      : Return the standard deviation of this trait.
     ///   sum         : Return the summation of all values of this trait (alias="total")
     ///   entropy     : Return the Shannon entropy of this value.
     ///   :trait      : Return the mutual information with another provided trait.
 
+    ///
+    ///  Summaries are cached; building the same summary again only re-runs preprocessing.
+
     template <typename FROM_T=Collection>
     std::function<Symbol_Var(const FROM_T &)> BuildTraitSummary(
-      std::string trait_fun,         // Function to calculate on each organism
-      std::string summary_type,      // Method to combine organism results ("max", "mean", etc.)
+      const std::string & trait_fun, // Function to calculate on each organism
+      const std::string & summary_type, // Method to combine organism results ("max", "mean", etc.)
       emp::DataLayout & data_layout  // DataLayout to assume for this summary
     ) {
       static_assert( std::is_same<FROM_T,Collection>() ||  std::is_same<FROM_T,Population>(),
                     "BuildTraitSummary FROM_T must be Collection or Population." );
 
       // Pre-process the trait function to allow for use of regular config variables.
-      trait_fun = Preprocess(trait_fun).result;
+      std::string pp_fun = Preprocess(trait_fun).result;
+
+      const std::string key = MakeCacheKey(data_layout, trait_fun, summary_type);
+      auto & entry = GetSummaryCache<FROM_T>()[key];
+      if (!entry.is_built || entry.pp_key != pp_fun) {
+        entry.fun = BuildTraitSummary_Preprocessed<FROM_T>(pp_fun, summary_type, data_layout, key);
+        entry.pp_key = std::move(pp_fun);
+        entry.is_built = true;
+      }
+      return entry.fun;
+    }
 
+  private:
+    /// Build a population summary that is computed along with all other planned summaries
+    /// for the same data layout.  The key identifies this summary, replacing any earlier
+    /// version of it.
+    std::function<Symbol_Var(const Population &)> PlanPopulationSummary(
+      const emp::DataLayout & data_layout,
+      const std::string & key,
+      const std::string & equation,
+      SummaryPlanner::value_fun_t get_fun,
+      const std::string & summary_type,
+      SummaryPlanner::batch_fun_t batch_fun=nullptr
+    ) {
+      auto summary_fun = BuildCollectFun<double, SummaryPlanner::ValueList>(summary_type,
+                                                                         DataCollect::IdentityFun{});
+      emp::Ptr<SummaryPlanner> planner = &summary_planners[&data_layout];
+      const size_t request_id =
+        planner->AddRequest(key, equation, get_fun, summary_fun, batch_fun);
+      return [planner, request_id](const Population & p){ return planner->GetResult(p, request_id); };
+    }
+
+    /// Helper for BuildTraitSummary() once the trait function has been preprocessed.
+    template <typename FROM_T>
+    std::function<Symbol_Var(const FROM_T &)> BuildTraitSummary_Preprocessed(
+      const std::string & trait_fun,
+      const std::string & summary_type,
+      emp::DataLayout & data_layout,
+      const std::string & key
+    ) {
       // The trait input has two components:
       // (1) the trait (or trait function) and
       // (2) how to calculate the trait SUMMARY, such as min, max, ave, etc.
 
+      // Bools packed into shared words are not in the layout themselves; read their bits.
+      if (emp::is_identifier(trait_fun) && !data_layout.HasName(trait_fun)) {
+        emp::Ptr<const TraitInfo> info_ptr = control.GetTraitInfo(trait_fun);
+        if (info_ptr && info_ptr->GetStorage() == TraitInfo::Storage::PACKED_BIT &&
+            data_layout.HasName(info_ptr->GetPackedWord())) {
+          const size_t word_id = data_layout.GetID(info_ptr->GetPackedWord());
+          const uint8_t mask = info_ptr->GetPackedMask();
+          auto get_fun = [word_id, mask](const Organism & org){
+            return (org.GetTrait<uint8_t>(word_id) & mask) ? 1.0 : 0.0;
+          };
+          auto fun = BuildCollectFun<double, Collection>(summary_type, get_fun);
+          if (!fun) {
+            emp::notify::Error("Unknown trait filter '", summary_type,
+                               "' for trait '", trait_fun, "'.");
+            return [](const FROM_T &){ return Symbol_Var(0); };
+          }
+          if constexpr (std::is_same<FROM_T,Population>()) {
+            return PlanPopulationSummary(data_layout, key, trait_fun, get_fun, summary_type);
+          }
+          else return fun;
+        }
+      }
+
       // If the function is just a single trait, identify it and get its ID.
       const bool is_single_trait = emp::is_identifier(trait_fun) && data_layout.HasName(trait_fun);
       size_t trait_id = is_single_trait ? data_layout.GetID(trait_fun) : emp::MAX_SIZE_T;
@@ -158,7 +356,37 @@ namespace mabe {
         const emp::TypeID result_type = data_layout.GetType(trait_id);
         const size_t trait_count = data_layout.GetCount(trait_id);
 
+        // Mode, richness, and entropy of a string trait count content hashes instead of copying
+        // every string (organisms may hash a trait without rendering it; see GetContentHash);
+        // populations tracking the trait maintain these counts incrementally.
+        if (result_type == emp::GetTypeID<std::string>() && trait_count == 1) {
+          auto hash_fun = [trait_id](const Organism & org) {
+            return org.GetContentHash(trait_id);
+          };
+          auto ref_fun = [trait_id](const Organism & org) -> const std::string & {
+            org.SyncTraits();
+            return org.GetTrait<std::string>(trait_id);
+          };
+          auto hashed_fun = BuildHashedCollectFun<Collection>(summary_type, hash_fun, ref_fun);
+          if (hashed_fun) {
+            if constexpr (std::is_same<FROM_T,Population>()) {
+              const TraitTracker::Stat stat = TraitTracker::ToStat(summary_type);
+              return [hashed_fun, trait_id, stat](const Population & p){
+                if (p.HasTrackedStat(trait_id, stat)) {
+                  return Symbol_Var( p.GetTrackedStat(trait_id, stat) );
+                }
+                if (stat == TraitTracker::Stat::NONE && p.HasTrackedTrait(trait_id)) {
+                  return Symbol_Var( p.GetTrackedMode(trait_id) );
+                }
+                return hashed_fun( Collection(p) );
+              };
+            }
+            else return hashed_fun;
+          }
+        }
+
         auto get_fun = [trait_id, result_type, trait_count](const Organism & org) {
+          org.SyncTraits();
           return org.GetTraitAsString(trait_id, result_type, trait_count);
         };
         auto fun = BuildCollectFun<std::string, Collection>(summary_type, get_fun);
@@ -173,7 +401,8 @@ namespace mabe {
       }
 
       // If we made it here, we are numeric.
-      auto get_fun = BuildTraitEquation(data_layout, trait_fun);
+      const TraitEquation & equ = GetTraitEquation(data_layout, trait_fun);
+      auto get_fun = [equ](const Organism & org){ return equ(org.GetDataMap()); };
       auto fun = BuildCollectFun<double, Collection>(summary_type, get_fun);
 
       // If we don't have a fun, we weren't able to build an aggregation function.
@@ -182,15 +411,31 @@ namespace mabe {
         return [](const FROM_T &){ return Symbol_Var(0); };
       }
 
-      // If we are processing a Population, first convert it to a Collection.
+      // If we are processing a Population, use tracked statistics or a mirrored trait column if
+      // either is available; otherwise compute it along with other summaries of the population.
       if constexpr (std::is_same<FROM_T,Population>()) {
-        return [fun](const Population & p){ return fun( Collection(p) ); };
+        auto planned_fun = PlanPopulationSummary(data_layout, key, trait_fun,
+          [get_fun](const Organism & org) -> double { return get_fun(org); }, summary_type,
+          MakeBatchFunction<Population>(equ));
+        if (is_single_trait) {
+          auto column_fun =
+            BuildCollectFun<double, TraitColumns::View>(summary_type, DataCollect::IdentityFun{});
+          const TraitTracker::Stat stat = TraitTracker::ToStat(summary_type);
+          return [planned_fun, column_fun, trait_id, stat](const Population & p){
+            if (p.HasTrackedStat(trait_id, stat)) {
+              return Symbol_Var( p.GetTrackedStat(trait_id, stat) );
+            }
+            if (p.HasTraitColumn(trait_id)) return column_fun( p.GetTraitColumnView(trait_id) );
+            return planned_fun(p);
+          };
+        }
+        return planned_fun;
       }
 
       return fun;
     }
 
-
+  public:
     /// Build a function that takes a trait equation, builds it, and runs it on a container.
     /// Output is a function in the form:  TO_T(const FROM_T &, string equation, TO_T default)
     template <typename FROM_T=Collection> 
@@ -221,6 +466,16 @@ namespace mabe {
         "Find the index of the largest value of a trait (or equation).");
       type_info.AddMemberFunction("CALC_MEDIAN", BuildTraitFunction<GROUP_T>("median"),
         "Find the 50-percentile value of a trait (or equation).");
+      type_info.AddMemberFunction("CALC_QUANTILE",
+        [this](GROUP_T & group, const std::string & equation, double q) {
+          return BuildTraitFunction<GROUP_T>(QuantileMode(q, false))(group, equation);
+        },
+        "Find the value at quantile Q (0.0 to 1.0) of a trait (or equation).");
+      type_info.AddMemberFunction("CALC_QUANTILE_APPROX",
+        [this](GROUP_T & group, const std::string & equation, double q) {
+          return BuildTraitFunction<GROUP_T>(QuantileMode(q, true))(group, equation);
+        },
+        "Estimate the value at quantile Q of a trait (or equation) using bounded memory.");
       type_info.AddMemberFunction("CALC_VARIANCE", BuildTraitFunction<GROUP_T>("variance"),
         "Find the variance of the distribution of values of a trait (or equation).");
       type_info.AddMemberFunction("CALC_STDDEV", BuildTraitFunction<GROUP_T>("stddev"),
@@ -229,6 +484,11 @@ namespace mabe {
         "Add up the total value of a trait (or equation).");
       type_info.AddMemberFunction("CALC_ENTROPY", BuildTraitFunction<GROUP_T>("entropy"),
         "Determine the entropy of values for a trait (or equation).");
+      type_info.AddMemberFunction("CALC_SUMMARY",
+        [this](GROUP_T & group, const std::string & equation, const std::string & mode) {
+          return BuildTraitFunction<GROUP_T>(mode)(group, equation);
+        },
+        "Summarize a trait (or equation); mode may be \"mean\", \"p90\", \"median~\", etc.");
 
       type_info.AddMemberFunction("FIND_MIN",
         [this](GROUP_T & group, const std::string & trait_equation) -> Collection {
@@ -251,6 +511,15 @@ namespace mabe {
   private:
     /// ======= Helper functions ===
 
+    /// Summary mode for quantile q (see BuildTraitSummary()).
+    static std::string QuantileMode(double q, bool approx) {
+      std::stringstream ss;
+      ss << std::fixed;
+      ss.precision(std::numeric_limits<double>::max_digits10);
+      ss << (approx ? "quantile~" : "quantile") << q;
+      return ss.str();
+    }
+
     /// Set up all of the functions and globals in MABEScript
     void Initialize() {
       // Setup main MABE variables.
@@ -259,6 +528,15 @@ namespace mabe {
                               [this](){ return control.GetRandomSeed(); },
                               [this](int seed){ control.SetRandomSeed(seed); },
                               "Seed for random number generator; use 0 to base on time.");
+      root_scope.LinkFuns<int>("num_threads",
+                              [this](){ return (int) control.GetNumThreads(); },
+                              [this](int count){ control.SetNumThreads((size_t) std::max(count, 0)); },
+                              "Number of threads for parallel evaluation; use 0 for all cores.");
+      root_scope.LinkFuns<std::string>("compact_traits",
+                              [this](){ return control.GetCompactTraits(); },
+                              [this](const std::string & names){ control.SetCompactTraits(names); },
+                              "Comma-separated traits to store compactly (bools as bits, doubles as\n"
+                              "floats); they must only be accessed through typed trait objects.");
 
       // Setup "Population" as a type in the config file.
       auto pop_init_fun = [this](const std::string & name) { return &control.AddPopulation(name); };
@@ -291,9 +569,11 @@ namespace mabe {
         [this](Population & pop, const std::string & trait_equation) -> Collection {
           Collection out_collect;
           if (pop.GetNumOrgs() > 0) { // Only do this work if we actually have organisms!
-            auto filter = BuildTraitEquation(pop.GetDataLayout(), trait_equation);
-            for (auto it = pop.begin(); it != pop.end(); ++it) {
-              if (filter(*it)) out_collect.Insert(it);
+            auto filter = BuildTraitEquationBatch<Population>(pop.GetDataLayout(), trait_equation);
+            emp::vector<double> results;
+            filter(pop, results);
+            for (size_t pos = 0; pos < results.size(); ++pos) {
+              if (results[pos]) out_collect.Insert(pop.IteratorAt(pos));
             }
           }
           return out_collect;
@@ -311,6 +591,15 @@ namespace mabe {
       AddFunction("GET_UPDATE", [this](){ return control.GetUpdate(); }, "Get current update.");
       AddFunction("GET_VERBOSE", [this](){ return control.GetVerbose(); }, "Has the verbose flag been set?");
       AddFunction("DEBUG_AST", [this](){ control.PrintAST(); return 0; }, "Print the current state of the Abstract Syntax Tree.");
+      AddFunction("CHECKPOINT", [this](const std::string & filename){
+                    control.SaveCheckpoint(filename); return 0;
+                  }, "Save the full state of this run to a file (resume with --restore).");
+      AddFunction("PROFILE_REPORT", [this](){ control.GetProfiler().PrintReport(); return 0; },
+                  "Print timing results collected so far (requires --profile).");
+      AddFunction("PRINT_TRAIT_STORAGE", [this](){ control.PrintTraitStorage(); return 0; },
+                  "Print the number of bytes each organism uses for each trait.");
+      AddFunction("PROFILE_RESET", [this](){ control.ResetProfiling(); return 0; },
+                  "Clear all timing results collected so far.");
 
       std::function<std::string(const std::string &)> preprocess_fun =
         [this](const std::string & str) { return Preprocess(str).result; };
@@ -10,6 +10,11 @@
 #ifndef MABE_MANAGER_MODULE_H
 #define MABE_MANAGER_MODULE_H
 
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
+#include "emp/base/vector.hpp"
 #include "emp/meta/TypeID.hpp"
 
 #include "MABE.hpp"
@@ -61,6 +66,18 @@ namespace mabe {
     /// Maintain a prototype for the objects being created.
     emp::Ptr<BASE_T> obj_prototype;
 
+    /// Objects that are no longer in use, available to be overwritten rather than reallocated.
+    emp::vector<emp::Ptr<MANAGED_T>> recycled;
+
+    size_t num_allocs = 0;  ///< How many objects have been allocated from the heap?
+    size_t num_reuses = 0;  ///< How many objects were built by reusing a recycled object?
+    size_t num_live = 0;    ///< How many cloned objects are currently in use?
+    size_t peak_live = 0;   ///< What is the most objects that have been in use at once?
+    size_t max_recycled = emp::MAX_SIZE_T;  ///< User limit on size of recycled list.
+
+    /// Track a newly cloned object as in use.
+    void NoteLive() { if (++num_live > peak_live) peak_live = num_live; }
+
   public:
     ManagerModule(MABE & in_control, const std::string & in_name, const std::string & in_desc="")
       : Module(in_control, in_name, in_desc)
@@ -68,7 +85,10 @@ namespace mabe {
       SetManageMod(); // @CAO should specify what type of object is managed.
       obj_prototype = emp::NewPtr<managed_t>(*this);
     }
-    virtual ~ManagerModule() { obj_prototype.Delete(); }
+    virtual ~ManagerModule() {
+      obj_prototype.Delete();
+      for (auto obj_ptr : recycled) obj_ptr.Delete();
+    }
 
     data_t & GetManagedData() { return data; }
     const data_t & GetManagedData() const { return data; }
@@ -79,9 +99,54 @@ namespace mabe {
     /// Also get the TypeID for more run-time type management.
     emp::TypeID GetObjType() const override { return emp::GetTypeID<managed_t>(); }
 
-    /// Create a clone of the provided object; default to using copy constructor.
+    size_t GetNumAllocs() const { return num_allocs; }
+    size_t GetNumReuses() const { return num_reuses; }
+    size_t GetNumRecycled() const { return recycled.size(); }
+    size_t GetMaxRecycled() const { return max_recycled; }
+
+    /// Limit how many dead objects are held for reuse; any extras are deleted.  Even without
+    /// a limit the list never grows beyond the peak number of objects in use at once.
+    void SetMaxRecycled(size_t in_max) {
+      max_recycled = in_max;
+      while (recycled.size() > max_recycled) {
+        recycled.back().Delete();
+        recycled.pop_back();
+      }
+    }
+
+    /// Create a clone of the provided object.  If a recycled object is available, copy into it
+    /// (with copy assignment, if possible, so that internal buffers can be reused); otherwise
+    /// default to using copy constructor.
     emp::Ptr<OrgType> CloneObject_impl(const OrgType & obj) override {
-      return emp::NewPtr<managed_t>( (const managed_t &) obj );
+      const managed_t & in_obj = (const managed_t &) obj;
+      if (recycled.size()) {
+        emp::Ptr<managed_t> obj_ptr = recycled.back();
+        recycled.pop_back();
+        if constexpr (std::is_copy_assignable<managed_t>()) {
+          *obj_ptr = in_obj;
+        } else {
+          obj_ptr->~managed_t();
+          new (obj_ptr.Raw()) managed_t(in_obj);
+        }
+        num_reuses++;
+        NoteLive();
+        return obj_ptr;
+      }
+      num_allocs++;
+      NoteLive();
+      control.GetProfiler().CountAlloc();
+      return emp::NewPtr<managed_t>(in_obj);
+    }
+
+    /// Hold on to objects that are no longer needed so their memory can be reused.  The list is
+    /// capped at the peak number of live objects (more could never be needed at once) and at
+    /// max_recycled; beyond that objects are returned to be deleted.
+    bool RecycleObject_impl(emp::Ptr<OrgType> obj_ptr) override {
+      emp_assert(obj_ptr.DynamicCast<managed_t>(), "Recycled object has the wrong type.");
+      if (num_live) num_live--;
+      if (recycled.size() >= std::min(peak_live, max_recycled)) return false;
+      recycled.push_back(obj_ptr.template Cast<managed_t>());
+      return true;
     }
 
     /// Create a random object from scratch.  Default to using the obj_prototype object.
@@ -102,6 +167,19 @@ namespace mabe {
       return control;
     }
 
+    // Setup member functions associated with this class.
+    static void InitType(emplode::TypeInfo & info) {
+      info.AddMemberFunction("NUM_ALLOCS",
+        [](ManagerModule & mod) { return mod.GetNumAllocs(); },
+        "Return the number of objects of this type allocated from the heap.");
+      info.AddMemberFunction("NUM_REUSES",
+        [](ManagerModule & mod) { return mod.GetNumReuses(); },
+        "Return the number of objects of this type built by reusing dead ones.");
+      info.AddMemberFunction("SET_MAX_RECYCLED",
+        [](ManagerModule & mod, size_t max) { mod.SetMaxRecycled(max); return max; },
+        "Limit how many dead objects of this type are kept for reuse (0 disables recycling).");
+    }
+
     void SetupConfig_Internal() override final {
       // Set traits created in the managed data to point to their actual module.
       for (emp::Ptr<BaseTrait> trait_ptr : data.trait_ptrs) {
@@ -144,6 +222,7 @@ namespace mabe {
         return &control.AddModule<MODULE_T>(name, desc);
       };
       new_info.type_init_fun = [](emplode::TypeInfo & info){ MODULE_T::InitType(info); };
+      new_info.type_id = emp::GetTypeID<MODULE_T>();
       GetModuleMap()[type_name] = new_info;
     }
   };
@@ -34,6 +34,7 @@
 #include "ModuleBase.hpp"
 #include "OrgTrait.hpp"
 #include "Population.hpp"
+#include "TraitHandle.hpp"
 #include "TraitInfo.hpp"
 
 namespace mabe {
@@ -102,6 +103,19 @@ namespace mabe {
       for (auto trait_ptr : trait_ptrs) {
         trait_ptr->SetupDataMap(dm);
       }      
+      for (auto handle_ptr : handle_ptrs) {
+        handle_ptr->Resolve(dm, GetTraitManager().GetTraitInfo(handle_ptr->GetName()));
+      }
+    }
+
+    bool HasTypedTraitAccess(const std::string & trait_name) const override {
+      for (auto trait_ptr : trait_ptrs) {
+        if (trait_ptr->GetName() == trait_name) return true;
+      }
+      for (auto handle_ptr : handle_ptrs) {
+        if (handle_ptr->GetName() == trait_name) return true;
+      }
+      return false;
     }
 
     // Specialized configuration links for MABE-specific modules.
@@ -210,6 +224,31 @@ namespace mabe {
       )
     }
 
+    /// Run eval_fun(org, random) on every living organism in the collection, spreading the
+    /// work across the controller's thread pool.  eval_fun may be called concurrently, so it
+    /// must only modify the organism it was given (plus any thread-safe state) and should use
+    /// the provided random number generator (one stream per chunk) rather than
+    /// control.GetRandom().  If eval_fun calls GenerateOutput(), organisms whose output is not
+    /// thread safe (see OrgType::IsOutputThreadSafe()) force the loop to run serially.
+    template <typename FUN_T>
+    void ParallelEvaluate(const Collection & orgs, FUN_T && eval_fun) {
+      emp::vector<emp::Ptr<Organism>> org_ptrs;
+      bool use_threads = true;
+      for (Organism & org : orgs.GetAlive()) {
+        org_ptrs.push_back(&org);
+        if (!org.IsOutputThreadSafe()) use_threads = false;
+      }
+      control.ParallelFor(org_ptrs.size(), [&org_ptrs, &eval_fun](size_t id, emp::Random & random) {
+        eval_fun(*org_ptrs[id], random);
+      }, 64, use_threads);
+    }
+
+    /// Mark the start of a script call (or other event) for this module, timing the call when
+    /// profiling is active; the returned timer records when it goes out of scope.
+    Profiler::Timer Profile(const std::string & event) {
+      return control.GetProfiler().StartTimer(GetName(), event);
+    }
+
     // ---== Trait management ==---
    
     /// Add a new trait to this module, specifying its access method, its name, and its description
@@ -343,6 +382,35 @@ namespace mabe {
       control.RescanSignals();
     }
 
+    // Format:  BeforePlacementBatch(std::span<const emp::Ptr<Organism>> orgs,
+    //                               std::span<const OrgPosition> target_pos,
+    //                               std::span<const OrgPosition> parent_pos)
+    // Trigger: A group of organisms is about to be placed.  Also triggered (with one entry)
+    //          for single placements; a module overriding this never gets BeforePlacement.
+    //          (Until signals are rescanned, this default passes each entry on to
+    //          BeforePlacement, since the module was not listed for it.)
+    // Args:    Organisms to be placed, placement positions, parent positions (if available)
+    void BeforePlacementBatch(std::span<const emp::Ptr<Organism>> orgs,
+                              std::span<const OrgPosition> target_pos,
+                              std::span<const OrgPosition> parent_pos) override {
+      has_signal[SIG_BeforePlacementBatch] = false;
+      control.RescanSignals();
+      for (size_t i = 0; i < orgs.size(); ++i) {
+        BeforePlacement(*orgs[i], target_pos[i], parent_pos[i]);
+      }
+    }
+
+    // Format:  OnPlacementBatch(std::span<const OrgPosition> placement_pos)
+    // Trigger: A group of organisms has been placed.  Also triggered (with one entry) for
+    //          single placements; a module overriding this never gets OnPlacement.
+    //          (Until signals are rescanned, this default passes each entry on to OnPlacement.)
+    // Args:    Positions new organisms were placed.
+    void OnPlacementBatch(std::span<const OrgPosition> placement_pos) override {
+      has_signal[SIG_OnPlacementBatch] = false;
+      control.RescanSignals();
+      for (OrgPosition pos : placement_pos) OnPlacement(pos);
+    }
+
     // Format:  BeforeMutate(Organism & org)
     // Trigger: Mutate is about to run on an organism.
     // Args:    Organism about to mutate.
@@ -399,6 +467,15 @@ namespace mabe {
       control.RescanSignals();
     }
 
+    // Format:  OnPopReplace(Population & to_pop, Population & from_pop)
+    // Trigger: All organisms in from_pop were just moved to the same positions in to_pop
+    //          (as a single bulk operation; no per-organism swap signals are triggered).
+    // Args:    Population now holding the organisms, population they were moved from (now empty).
+    void OnPopReplace(Population &, Population &) override {
+      has_signal[SIG_OnPopReplace] = false;
+      control.RescanSignals();
+    }
+
     // Format:  BeforeExit()
     // Trigger: Run immediately before MABE is about to exit.
     void BeforeExit() override {
@@ -432,6 +509,8 @@ namespace mabe {
     bool OnInjectReady_IsTriggered() override { return control.OnInjectReady_IsTriggered(this); };
     bool BeforePlacement_IsTriggered() override { return control.BeforePlacement_IsTriggered(this); };
     bool OnPlacement_IsTriggered() override { return control.OnPlacement_IsTriggered(this); };
+    bool BeforePlacementBatch_IsTriggered() override { return control.BeforePlacementBatch_IsTriggered(this); };
+    bool OnPlacementBatch_IsTriggered() override { return control.OnPlacementBatch_IsTriggered(this); };
     bool BeforeMutate_IsTriggered() override { return control.BeforeMutate_IsTriggered(this); };
     bool OnMutate_IsTriggered() override { return control.OnMutate_IsTriggered(this); };
     bool BeforeDeath_IsTriggered() override { return control.BeforeDeath_IsTriggered(this); };
@@ -439,6 +518,7 @@ namespace mabe {
     bool OnSwap_IsTriggered() override { return control.OnSwap_IsTriggered(this); };
     bool BeforePopResize_IsTriggered() override { return control.BeforePopResize_IsTriggered(this); };
     bool OnPopResize_IsTriggered() override { return control.OnPopResize_IsTriggered(this); };
+    bool OnPopReplace_IsTriggered() override { return control.OnPopReplace_IsTriggered(this); };
     bool BeforeExit_IsTriggered() override { return control.BeforeExit_IsTriggered(this); };
     bool OnHelp_IsTriggered() override { return control.OnHelp_IsTriggered(this); };
 
@@ -34,6 +34,14 @@
  *       : Placement location has been identified (For birth or inject)
  *     OnPlacement(OrgPosition placement_pos)
  *       : New organism has been placed in the population.
+ *     BeforePlacementBatch(std::span<const emp::Ptr<Organism>> orgs,
+ *                          std::span<const OrgPosition> target_pos,
+ *                          std::span<const OrgPosition> parent_pos)
+ *       : A group of organisms is about to be placed (also triggered for single placements;
+ *         replaces BeforePlacement for modules that override both).
+ *     OnPlacementBatch(std::span<const OrgPosition> placement_pos)
+ *       : A group of organisms has been placed (also triggered for single placements;
+ *         replaces OnPlacement for modules that override both).
  *     BeforeMutate(Organism & org)
  *       : Mutate is about to run on an organism.
  *     OnMutate(Organism & org)
@@ -48,6 +56,8 @@
  *       : Full population is about to be resized.
  *     OnPopResize(Population & pop, size_t old_size)
  *       : Full population has just been resized.
+ *     OnPopReplace(Population & to_pop, Population & from_pop)
+ *       : All orgs in from_pop were just moved to the same positions in to_pop.
  *     BeforeExit()
  *       : Run immediately before MABE is about to exit.
  *     OnHelp()
@@ -58,7 +68,10 @@
 #ifndef MABE_MODULE_BASE_H
 #define MABE_MODULE_BASE_H
 
+#include <istream>
+#include <ostream>
 #include <set>
+#include <span>
 #include <string>
 
 #include "emp/base/map.hpp"
@@ -75,6 +88,7 @@
 namespace mabe {
 
   class BaseTrait;
+  class TraitHandleBase;
   class MABE;
   class OrgType;
   class Organism;
@@ -88,6 +102,9 @@ namespace mabe {
     /// Trait object used in this module.
     emp::vector<emp::Ptr<BaseTrait>> trait_ptrs;
 
+    /// Trait handles to be resolved once the DataMap is locked.
+    emp::vector<emp::Ptr<TraitHandleBase>> handle_ptrs;
+
     virtual ~TraitHolder() { }
   };
 
@@ -131,6 +148,8 @@ namespace mabe {
       SIG_OnInjectReady,
       SIG_BeforePlacement,
       SIG_OnPlacement,
+      SIG_BeforePlacementBatch,
+      SIG_OnPlacementBatch,
       SIG_BeforeMutate,
       SIG_OnMutate,
       SIG_BeforeDeath,
@@ -138,6 +157,7 @@ namespace mabe {
       SIG_OnSwap,
       SIG_BeforePopResize,
       SIG_OnPopResize,
+      SIG_OnPopReplace,
       SIG_BeforeExit,
       SIG_OnHelp,
       NUM_SIGNALS,
@@ -161,6 +181,9 @@ namespace mabe {
       emp_assert(false, "Make_impl() must be overridden for ManagerModule.");
       return nullptr;
     }
+    /// Take ownership of an object that is no longer needed so that it can be reused; return
+    /// false if this module cannot recycle objects (and the caller should delete it instead).
+    virtual bool RecycleObject_impl(emp::Ptr<OrgType>) { return false; }
 
   public:
     ModuleBase(MABE & in_control, const std::string & in_name, const std::string & in_desc="")
@@ -228,6 +251,17 @@ namespace mabe {
     /// Internal notification of DataMaps being locked in.
     virtual void SetupDataMap_Internal(emp::DataMap &) = 0;
 
+    /// Does this module reach the named trait through an OrgTrait or TraitHandle (which can
+    /// follow compact storage) rather than by name?
+    virtual bool HasTypedTraitAccess(const std::string & /*trait_name*/) const { return false; }
+
+    /// Save any internal state (beyond configuration) needed to resume a run from a checkpoint.
+    /// Return false if the module has state that cannot be saved (users will be warned).
+    virtual bool SaveState(std::ostream &) const { return true; /* Default: no state to save. */ }
+
+    /// Restore internal state previously written by SaveState(); return success.
+    virtual bool LoadState(std::istream &) { return true; }
+
     // ----==== SIGNALS ====----
 
     // Base classes for signals to be called (More details in Module.h)
@@ -239,6 +273,10 @@ namespace mabe {
     virtual void OnInjectReady(Organism &, Population &) = 0;
     virtual void BeforePlacement(Organism &, OrgPosition, OrgPosition) = 0;
     virtual void OnPlacement(OrgPosition) = 0;
+    virtual void BeforePlacementBatch(std::span<const emp::Ptr<Organism>>,
+                                      std::span<const OrgPosition>,
+                                      std::span<const OrgPosition>) = 0;
+    virtual void OnPlacementBatch(std::span<const OrgPosition>) = 0;
     virtual void BeforeMutate(Organism &) = 0;
     virtual void OnMutate(Organism &) = 0;
     virtual void BeforeDeath(OrgPosition) = 0;
@@ -246,6 +284,7 @@ namespace mabe {
     virtual void OnSwap(OrgPosition, OrgPosition) = 0;
     virtual void BeforePopResize(Population &, size_t) = 0;
     virtual void OnPopResize(Population &, size_t) = 0;
+    virtual void OnPopReplace(Population &, Population &) = 0;
     virtual void BeforeExit() = 0;
     virtual void OnHelp() = 0;
 
@@ -259,6 +298,8 @@ namespace mabe {
     virtual bool OnInjectReady_IsTriggered() = 0;
     virtual bool BeforePlacement_IsTriggered() = 0;
     virtual bool OnPlacement_IsTriggered() = 0;
+    virtual bool BeforePlacementBatch_IsTriggered() = 0;
+    virtual bool OnPlacementBatch_IsTriggered() = 0;
     virtual bool BeforeMutate_IsTriggered() = 0;
     virtual bool OnMutate_IsTriggered() = 0;
     virtual bool BeforeDeath_IsTriggered() = 0;
@@ -266,6 +307,7 @@ namespace mabe {
     virtual bool OnSwap_IsTriggered() = 0;
     virtual bool BeforePopResize_IsTriggered() = 0;
     virtual bool OnPopResize_IsTriggered() = 0;
+    virtual bool OnPopReplace_IsTriggered() = 0;
     virtual bool BeforeExit_IsTriggered() = 0;
     virtual bool OnHelp_IsTriggered() = 0;
 
@@ -292,6 +334,13 @@ namespace mabe {
     emp::Ptr<OBJ_T> Make(emp::Random & random) {
       return MakeRandom_impl(random).template DynamicCast<OBJ_T>();
     }
+
+    /// Dispose of an object built by this module; it is recycled when possible and deleted
+    /// otherwise.  The object should not be used again after this call.
+    template <typename OBJ_T>
+    void RecycleObject(emp::Ptr<OBJ_T> obj_ptr) {
+      if (!RecycleObject_impl(obj_ptr)) obj_ptr.Delete();
+    }
   };
 
   struct ModuleInfo {
@@ -17,6 +17,7 @@
 
 #include "ModuleBase.hpp"
 #include "TraitInfo.hpp"
+#include "TraitStorage.hpp"
 
 namespace mabe {
 
@@ -86,7 +87,7 @@ namespace mabe {
     void SetName(const std::string & _name) { name = _name; }
     void SetConfigName(const std::string & _name) { config_name = _name; }
     void SetConfigDesc(const std::string & _desc) { config_desc = _desc; }
-    void SetupDataMap(const emp::DataMap & dm) { id = dm.GetID(name); }
+    virtual void SetupDataMap(const emp::DataMap & dm) { id = dm.GetID(name); }
 
     virtual bool ReadOK() const = 0;
     virtual bool WriteOK() const = 0;
@@ -100,24 +101,47 @@ namespace mabe {
             bool MULTI>                  // Does this trait have multiple values?
   struct OrgTrait : public BaseTrait {
     T default_value{};
+    TraitLocation location;  ///< Where a single-value trait is stored (may be compact).
 
-    // The get type should be a T & for a single value or a span<T> for multiple values.
-    using get_t = typename std::conditional<MULTI, std::span<T>, T &>::type;
-    using const_get_t = typename std::conditional<MULTI, std::span<const T>, const T &>::type;
+    // The get type should be a T & for a single value or a span<T> for multiple values.  Single
+    // bools and doubles use reference-like objects, in case they use compact storage.
+    using get_t = typename std::conditional<MULTI, std::span<T>,
+                                            typename TraitRefType<T>::type>::type;
+    using const_get_t = typename std::conditional<MULTI, std::span<const T>,
+                                                  typename TraitRefType<T>::const_type>::type;
 
     template<typename... Ts>
     OrgTrait(Ts &&... args) : BaseTrait(ACCESS, MULTI, std::forward<Ts>(args)...) { }
 
     /// Get() takes an organism and returns the trait reference for that organism.
+    /// Writable traits notify the organism's tracker (if any) that they may be modified, so use
+    /// Read() when only reading.
     get_t Get(mabe::Organism & org) const {
-      if constexpr (MULTI) return org.GetTrait<T>(id, GetCount());
-      else return org.GetTrait<T>(id);
+      if constexpr (ACCESS != TraitInfo::REQUIRED && ACCESS != TraitInfo::OPTIONAL) {
+        org.NoteTraitWrite();
+      }
+      if constexpr (MULTI) {
+        emp::AnnotatedType & traits = org;   // Already marked above (if needed).
+        return traits.GetTrait<T>(id, GetCount());
+      }
+      else return location.Access<T>(org);
     }
 
     /// Get() takes a const organism and returns the trait value for that organism.
     const_get_t Get(const mabe::Organism & org) const {
       if constexpr (MULTI) return org.GetTrait<T>(id, GetCount());
-      else return org.GetTrait<T>(id);
+      else return location.Access<T>(org);
+    }
+
+    /// Read() returns the trait value for an organism, without marking it as modified.
+    const_get_t Read(const mabe::Organism & org) const { return Get(org); }
+
+    /// Locate this trait once the DataMap is finalized, including any compact storage.
+    void SetupDataMap(const emp::DataMap & dm) override {
+      emp::Ptr<const TraitInfo> info_ptr = nullptr;
+      if (this->module_ptr) info_ptr = this->module_ptr->GetTraitManager().GetTraitInfo(name);
+      location.Locate(dm, name, info_ptr);
+      id = location.id;
     }
 
     /// A trait supplied with an organism converts to the trait reference for that organism.
@@ -178,7 +202,10 @@ namespace mabe {
       : BaseTrait(TraitInfo::Access::REQUIRED, false, held_ptr, name, desc) { }
 
     /// Get() takes an organism and returns the trait reference for that organism.
-    std::string Get(mabe::Organism & org) const { return org.GetTraitAsString(id); }
+    std::string Get(mabe::Organism & org) const {
+      org.SyncTraits();
+      return org.GetTraitAsString(id);
+    }
 
     /// A trait supplied with an organism converts to the trait reference for that organism.
     inline std::string operator()(mabe::Organism & org) const { return Get(org); }
@@ -190,6 +217,7 @@ namespace mabe {
       emp::vector<std::string> out_v;
       out_v.reserve(num_orgs);
       for (auto & org : collect) {
+        org.SyncTraits();
         out_v.push_back(org.GetTraitAsString(id));
       }
       return out_v;
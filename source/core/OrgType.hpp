@@ -25,11 +25,20 @@ namespace mabe {
   class OrgType {
   protected:
     ModuleBase & manager;    ///< Manager for the specific organism type
+    bool end_slice = false;  ///< Should the current ProcessSteps() call stop early?
 
   public:
     OrgType(ModuleBase & _man) : manager(_man) { ; }
+    OrgType(const OrgType &) = default;
     virtual ~OrgType() { ; }
 
+    /// Copying into an existing object (e.g., when a manager recycles a dead organism) keeps
+    /// the original manager; both objects must already share the same one.
+    OrgType & operator=(const OrgType & in) {
+      emp_assert(&manager == &in.manager, "Can only assign between objects with the same manager.");
+      return *this;
+    }
+
     /// Get the manager for this type of organism.
     Module & GetManager() { return (Module&) manager; }
     const Module & GetManager() const { return (Module&) manager; }
@@ -120,8 +129,41 @@ namespace mabe {
     /// Run the organism to generate an output in the pre-configured data_map entries.
     virtual void GenerateOutput() { ; }
 
+    /// Bring up to date any traits this organism only computes when read (such as a rendered
+    /// genome); code reading such traits from outside the organism calls this first.
+    virtual void SyncTraits() const { ; }
+
+    /// Can GenerateOutput() run on many organisms of this type at once?  It must then only
+    /// modify this organism (no shared manager data, no control.GetRandom()).
+    virtual bool IsOutputThreadSafe() const { return false; }
+
     /// Run the organisms a single time step; only implemented for continuous execution organisms.
     virtual bool ProcessStep() { return false; }
+
+    /// Stop the current time slice after this step.  Must be called by any step that might
+    /// remove this organism (such as reproducing, where the offspring may replace the parent).
+    void EndTimeSlice() { end_slice = true; }
+
+    /// Run the organism for up to num_steps time steps in a row; return how many were run.
+    /// Override to process a whole time slice more efficiently than separate steps, but stop
+    /// as soon as EndTimeSlice() has been called.
+    virtual size_t ProcessSteps(size_t num_steps) {
+      end_slice = false;
+      size_t step = 0;
+      while (step < num_steps && ProcessStep()) {
+        ++step;
+        if (end_slice) break;
+      }
+      return step;
+    }
+
+    /// Write the genome (and any other state not stored in traits) for a checkpoint.
+    /// @note Required for checkpointing; return false if this organism type cannot be saved.
+    virtual bool SaveState(std::ostream &) const { return false; }
+
+    /// Restore state written by SaveState() into a newly built organism (traits are restored
+    /// separately); return success.
+    virtual bool LoadState(std::istream &) { return false; }
  
     // virtual bool AddEvent(const std::string & event_name, int event_id) { return false; }
     // virtual void TriggerEvent(int) { ; }
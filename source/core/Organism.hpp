@@ -27,22 +27,146 @@
 #ifndef MABE_ORGANISM_H
 #define MABE_ORGANISM_H
 
+#include <list>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
 #include "emp/base/assert.hpp"
 #include "emp/base/vector.hpp"
 #include "emp/data/AnnotatedType.hpp"
 #include "emp/tools/string_utils.hpp"
 
+#include "HashCounts.hpp"
 #include "OrgType.hpp"
+#include "TraitTracker.hpp"
 
 namespace mabe {
 
   class Population;
 
+  /// Debug-build tally of organism traits accessed by name (each a hash lookup); a high count
+  /// indicates a code path that should use a TraitHandle instead.  Each thread tallies into its
+  /// own map (registered once, under the mutex), so counting never takes a lock; totals should
+  /// only be collected between parallel loops.
+  class TraitNameLookups {
+  private:
+    using counts_t = std::map<std::string, size_t>;
+    static inline std::mutex mutex;                 ///< Protects thread_counts.
+    static inline std::list<counts_t> thread_counts; ///< One tally per thread that has counted.
+
+    static counts_t & LocalCounts() {
+      thread_local counts_t * counts_ptr = nullptr;
+      if (!counts_ptr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        counts_ptr = &thread_counts.emplace_back();
+      }
+      return *counts_ptr;
+    }
+
+    /// Merge all thread tallies (mutex must be held).
+    static counts_t Merge() {
+      counts_t total;
+      for (const counts_t & counts : thread_counts) {
+        for (const auto & [name, count] : counts) total[name] += count;
+      }
+      return total;
+    }
+
+  public:
+    static void Add([[maybe_unused]] const std::string & name) {
+#ifndef NDEBUG
+      ++LocalCounts()[name];
+#endif
+    }
+    static size_t GetTotal() {
+      std::lock_guard<std::mutex> lock(mutex);
+      size_t total = 0;
+      for (const counts_t & counts : thread_counts) {
+        for (const auto & [name, count] : counts) total += count;
+      }
+      return total;
+    }
+    static void Reset() {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (counts_t & counts : thread_counts) counts.clear();
+    }
+    /// Print the count for each trait looked up by name, then reset.
+    static void Report(std::ostream & os) {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (const auto & [name, count] : Merge()) {
+        os << "  " << name << " : " << count << " lookups by name\n";
+      }
+      for (counts_t & counts : thread_counts) counts.clear();
+    }
+  };
+
   class Organism : public OrgType, public emp::AnnotatedType {
   private:
     emp::Ptr<Population> pop_ptr = nullptr;
+    emp::Ptr<TraitTracker> tracker_ptr = nullptr;  ///< Statistics to notify when traits change.
+    size_t tracker_pos = 0;                         ///< Position to mark in tracker.
+
   public:
+    using emp::AnnotatedType::GetTrait;
+    using emp::AnnotatedType::SetTrait;
+
+    // Non-const access to traits (by name or ID) may modify them, so must notify any tracker;
+    // const access never does.  Lookups by name are also counted in debug builds (see
+    // TraitNameLookups).
+    template <typename T>
+    T & GetTrait(size_t id) {
+      NoteTraitWrite();
+      return emp::AnnotatedType::GetTrait<T>(id);
+    }
+    template <typename T>
+    decltype(auto) GetTrait(size_t id, size_t count) {
+      NoteTraitWrite();
+      return emp::AnnotatedType::GetTrait<T>(id, count);
+    }
+    template <typename T>
+    decltype(auto) SetTrait(size_t id, const T & value) {
+      NoteTraitWrite();
+      return emp::AnnotatedType::SetTrait<T>(id, value);
+    }
+    template <typename T>
+    T & GetTrait(const std::string & name) {
+#ifndef NDEBUG
+      TraitNameLookups::Add(name);
+#endif
+      NoteTraitWrite();
+      return emp::AnnotatedType::GetTrait<T>(name);
+    }
+    template <typename T>
+    const T & GetTrait(const std::string & name) const {
+#ifndef NDEBUG
+      TraitNameLookups::Add(name);
+#endif
+      return emp::AnnotatedType::GetTrait<T>(name);
+    }
+    template <typename T>
+    decltype(auto) SetTrait(const std::string & name, const T & value) {
+#ifndef NDEBUG
+      TraitNameLookups::Add(name);
+#endif
+      NoteTraitWrite();
+      return emp::AnnotatedType::SetTrait<T>(name, value);
+    }
+
     Organism(ModuleBase & _man) : OrgType(_man) { ; }
+
+    /// Copies are not tracked until they are placed, so must not notify the original's tracker.
+    Organism(const Organism & in)
+      : OrgType(in), emp::AnnotatedType(in), pop_ptr(in.pop_ptr) { }
+
+    /// Assignment copies organism contents, but never population membership.
+    Organism & operator=(const Organism & in) {
+      OrgType::operator=(in);
+      emp::AnnotatedType::operator=(in);
+      return *this;
+    }
+
     virtual ~Organism() {
       emp_assert(
         pop_ptr.IsNull(),
@@ -56,7 +180,29 @@ namespace mabe {
     emp::Ptr<Population> GetPopPtr() const { return pop_ptr; }
     Population & GetPopulation() { return *pop_ptr; }
     void SetPopulation(Population & in) { pop_ptr = &in; }
-    void ClearPopulation() { pop_ptr = nullptr; }
+    void ClearPopulation() { pop_ptr = nullptr; tracker_ptr = nullptr; }
+
+    /// Set up the trait statistics (if any) that should be notified when traits are written.
+    void SetTraitTracker(emp::Ptr<TraitTracker> in_ptr, size_t in_pos) {
+      tracker_ptr = in_ptr;
+      tracker_pos = in_pos;
+    }
+
+    /// Note that one of this organism's traits may have been modified; non-const trait access
+    /// does this automatically, but writes made directly through the DataMap do not.  Both the
+    /// population's tracker and epoch-based caches (see TraitColumns) are told.
+    void NoteTraitWrite() {
+      TraitColumns::NoteTraitChange();
+      if (tracker_ptr) tracker_ptr->MarkDirty(tracker_pos);
+    }
+
+    /// Content hash (see HashCounts.hpp) of a single string trait, used to count distinct values
+    /// without copying them.  Organism types that can hash a trait without rendering it (such
+    /// as from a maintained genome hash) should override this.
+    virtual uint64_t GetContentHash(size_t trait_id) const {
+      SyncTraits();
+      return ContentHash(GetTrait<std::string>(trait_id));
+    }
 
     /// Specialty version of Clone to return an Organism type.
     [[nodiscard]] virtual emp::Ptr<Organism> CloneOrganism() const {
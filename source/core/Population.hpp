@@ -16,7 +16,10 @@
 #ifndef MABE_POPULATION_H
 #define MABE_POPULATION_H
 
+#include <algorithm>
+#include <span>
 #include <string>
+#include <utility>
 
 #include "emp/base/Ptr.hpp"
 #include "emp/base/vector.hpp"
@@ -25,6 +28,8 @@
 
 #include "Organism.hpp"
 #include "OrgIterator.hpp"
+#include "TraitColumns.hpp"
+#include "TraitTracker.hpp"
 
 namespace mabe {
 
@@ -91,6 +96,18 @@ namespace mabe {
     emp::vector<emp::Ptr<Organism>> orgs;  ///< Info on all organisms in this population.
     size_t num_orgs = 0;                   ///< How many LIVING organisms are in this population?
 
+    // Track where living organisms are for constant-time sampling and sparse iteration.
+    emp::vector<size_t> living_pos;        ///< Dense list of all occupied positions.
+    emp::vector<size_t> living_index;      ///< For each position, index in living_pos (or -1)
+
+    size_t org_version = 0;                ///< Incremented whenever the set of organisms changes.
+
+    // Optional incrementally-updated statistics and contiguous copies of numeric traits;
+    // organisms mark their position when changed, and values are refreshed lazily.
+    mutable TraitTracker trait_tracker;    ///< Running statistics and mirrored trait columns.
+    emp::vector<std::string> mirror_names; ///< Traits to mirror (resolved once layout is known).
+    emp::vector<std::string> track_names;  ///< Traits to track (resolved once layout is known).
+
     /// Pointer to layout used in data maps of orgs.
     emp::Ptr<emp::DataLayout> data_layout_ptr = nullptr; 
 
@@ -101,6 +118,8 @@ namespace mabe {
     std::function<OrgPosition(Organism &)> place_inject_fun;
     std::function<OrgPosition(OrgPosition)> find_neighbor_fun;
 
+    static constexpr size_t NO_INDEX = (size_t) -1;
+
   public:
     using iterator_t = PopIterator;
     using const_iterator_t = ConstPopIterator;
@@ -113,6 +132,7 @@ namespace mabe {
       : name(in_name), pop_id(in_id), empty_org(in_empty)
     {
       orgs.resize(pop_size, empty_org);
+      living_index.resize(pop_size, NO_INDEX);
     }
 
     // All organism moving/copying must be tracked and done through MABE object.
@@ -127,6 +147,7 @@ namespace mabe {
     int GetID() const noexcept override { return pop_id; }
     size_t GetSize() const noexcept override { return orgs.size(); }
     size_t GetNumOrgs() const noexcept { return num_orgs; }
+    size_t GetOrgVersion() const noexcept { return org_version; }
     bool IsEmpty() const noexcept override { return num_orgs == 0; }
 
     bool HasDataLayout() const { return data_layout_ptr; }
@@ -143,9 +164,83 @@ namespace mabe {
     bool IsEmpty(size_t pos) const { return IsValid(pos) && orgs[pos]->IsEmpty(); }
     bool IsOccupied(size_t pos) const { return IsValid(pos) && !orgs[pos]->IsEmpty(); }
 
+    /// Get the list of all occupied positions (in no particular order).
+    const emp::vector<size_t> & GetLivingPositions() const noexcept { return living_pos; }
+
+    /// Get the position of the id'th living organism (in no particular order);
+    /// use with a random id in [0, GetNumOrgs()) for constant-time sampling of living orgs.
+    size_t GetLivingPos(size_t id) const {
+      emp_assert(id < living_pos.size(), id, living_pos.size());
+      return living_pos[id];
+    }
+
     void SetName(const std::string & in_name) { name = in_name; }
     void SetID(int in_id) noexcept { pop_id = in_id; }
 
+    /// Keep a contiguous copy of a numeric trait for fast population-wide scans.
+    void MirrorTrait(const std::string & trait_name) {
+      if (std::find(mirror_names.begin(), mirror_names.end(), trait_name) != mirror_names.end()) {
+        return;
+      }
+      mirror_names.push_back(trait_name);
+      if (data_layout_ptr) ResolveMirrors();
+    }
+
+    /// Is the trait with the given ID being mirrored?
+    bool HasTraitColumn(size_t trait_id) const { return trait_tracker.HasColumn(trait_id); }
+
+    /// Get the value of a mirrored trait for each position (empty cells hold the values of
+    /// the empty organism), re-reading only organisms changed since last time.
+    std::span<const double> GetTraitColumn(size_t trait_id) const {
+      trait_tracker.Update(orgs);
+      return trait_tracker.GetColumn(trait_id);
+    }
+
+    /// Get the values of a mirrored trait for every position, for use with DataCollect.
+    TraitColumns::View GetTraitColumnView(size_t trait_id) const {
+      trait_tracker.Update(orgs);
+      return trait_tracker.GetColumnView(trait_id);
+    }
+
+    /// Maintain running statistics (count, sum, mean, variance, min, max) for a numeric trait,
+    /// or counts of content hashes (richness, entropy, mode) for a string trait such as a
+    /// genome; they are updated only for organisms that changed.
+    void TrackTrait(const std::string & trait_name) {
+      if (std::find(track_names.begin(), track_names.end(), trait_name) != track_names.end()) {
+        return;
+      }
+      track_names.push_back(trait_name);
+      if (data_layout_ptr) ResolveTracked();
+    }
+
+    /// Does this population maintain running statistics for the trait with the given ID?
+    bool HasTrackedTrait(size_t trait_id) const { return trait_tracker.HasTrait(trait_id); }
+
+    /// Is the given statistic being maintained for the trait with the given ID?
+    bool HasTrackedStat(size_t trait_id, TraitTracker::Stat stat) const {
+      return trait_tracker.HasStat(trait_id, stat);
+    }
+
+    /// Get a statistic for a tracked trait, revisiting only organisms changed since last time.
+    double GetTrackedStat(size_t trait_id, TraitTracker::Stat stat) const {
+      trait_tracker.Update(orgs);
+      return trait_tracker.GetStat(trait_id, stat);
+    }
+
+    /// Get the most common value of a string trait tracked by hash ("" if no organisms).
+    std::string GetTrackedMode(size_t trait_id) const {
+      emp_assert(trait_tracker.IsHashed(trait_id), trait_id);
+      trait_tracker.Update(orgs);
+      const size_t pos = trait_tracker.GetModePos(trait_id);
+      if (pos == TraitTracker::NO_POS) return std::string{};
+      orgs[pos]->SyncTraits();
+      return orgs[pos]->GetTrait<std::string>(trait_id);
+    }
+
+    /// Note that all tracked statistics must be recomputed (for example, after trait writes
+    /// that bypass OrgTrait, TraitHandle, and by-name access).
+    void NoteAllTraitsChanged() { trait_tracker.MarkAll(); }
+
     template <typename FUN_T> void SetPlaceBirthFun(FUN_T fun) { place_birth_fun = fun; }
     template <typename FUN_T> void SetPlaceInjectFun(FUN_T fun) { place_inject_fun = fun; }
     template <typename FUN_T> void SetFindNeighborFun(FUN_T fun) { find_neighbor_fun = fun; }
@@ -169,19 +264,67 @@ namespace mabe {
 
   private:  // ---== To be used by friend class MABEBase only! ==---
 
+    /// Set up columns for any requested traits (once the data layout is known).
+    void ResolveMirrors() {
+      emp_assert(data_layout_ptr);
+      const bool was_active = trait_tracker.IsActive();
+      for (const std::string & trait_name : mirror_names) {
+        if (!trait_tracker.AddColumn(*data_layout_ptr, trait_name)) {
+          emp::notify::Warning("Population '", name, "' cannot mirror trait '", trait_name,
+                               "'; only single numeric traits may be mirrored.");
+        }
+      }
+      mirror_names.resize(0);
+      if (!was_active) AttachAllTrackers();
+    }
+
+    /// Set up statistics for any requested traits (once the data layout is known).
+    void ResolveTracked() {
+      emp_assert(data_layout_ptr);
+      const bool was_active = trait_tracker.IsActive();
+      for (const std::string & trait_name : track_names) {
+        if (!trait_tracker.AddTrait(*data_layout_ptr, trait_name)) {
+          emp::notify::Warning("Population '", name, "' cannot track trait '", trait_name,
+                               "'; only single numeric traits may be tracked.");
+        }
+      }
+      track_names.resize(0);
+      if (!was_active) AttachAllTrackers();
+    }
+
+    /// Once a tracker is in use, organisms already present must start notifying it.
+    void AttachAllTrackers() {
+      if (!trait_tracker.IsActive()) return;
+      for (size_t pos : living_pos) orgs[pos]->SetTraitTracker(&trait_tracker, pos);
+    }
+
+    /// Organisms only notify the tracker if one is in use.
+    void AttachTracker(Organism & org, size_t pos) {
+      if (trait_tracker.IsActive()) org.SetTraitTracker(&trait_tracker, pos);
+    }
+
     void SetOrg(size_t pos, emp::Ptr<Organism> org_ptr) {
       emp_assert(pos < orgs.size());
       emp_assert(IsEmpty(pos));         // Must be valid and should not overwrite a living cell.
       emp_assert(!org_ptr->IsEmpty());  // Use ExtractOrg if you want to make a cell empty.
       orgs[pos] = org_ptr;
       org_ptr->SetPopulation(*this);
-      if (!data_layout_ptr) data_layout_ptr = &org_ptr->GetDataMap().GetLayout();
+      if (!data_layout_ptr) {
+        data_layout_ptr = &org_ptr->GetDataMap().GetLayout();
+        if (mirror_names.size()) ResolveMirrors();
+        if (track_names.size()) ResolveTracked();
+      }
 
       if ( data_layout_ptr != &org_ptr->GetDataMap().GetLayout() ) {
         emp::notify::Error("Trying to insert an organism into population '", name,
                            "' with the incorrect trait set.");
       }
+      living_index[pos] = living_pos.size();
+      living_pos.push_back(pos);
       num_orgs++;
+      org_version++;
+      AttachTracker(*org_ptr, pos);
+      trait_tracker.MarkDirty(pos);
     }
 
     /// Remove (and return) the organism at pos, but don't delete it.
@@ -191,7 +334,16 @@ namespace mabe {
       emp::Ptr<Organism> out_org = orgs[pos];
       orgs[pos] = empty_org;
       if (!out_org->IsEmpty()) {
+        // Remove this position from the living list by moving the last entry into its place.
+        const size_t index = living_index[pos];
+        const size_t moved_pos = living_pos.back();
+        living_pos[index] = moved_pos;
+        living_index[moved_pos] = index;
+        living_pos.pop_back();
+        living_index[pos] = NO_INDEX;
         num_orgs--;
+        org_version++;
+        trait_tracker.MarkDirty(pos);
         out_org->ClearPopulation(); // Alert organism that it is no longer part of this population.
       }
       return out_org;
@@ -206,16 +358,58 @@ namespace mabe {
 
       // Resize the population, adding in empty cells to any new spaces.
       orgs.resize(new_size, empty_org);
+      living_index.resize(new_size, NO_INDEX);
+      org_version++;
+      trait_tracker.MarkAll();
 
       return *this;
     }
 
+    /// Take over all organisms from another population (which will be left with size zero);
+    /// this population must not have any living organisms.  Only pointers are moved, but
+    /// organisms must be told their new population.
+    void TakeOrgs(Population & from_pop) {
+      emp_assert(num_orgs == 0);
+      emp_assert(&from_pop != this);
+
+      if (from_pop.num_orgs && data_layout_ptr && data_layout_ptr != from_pop.data_layout_ptr) {
+        emp::notify::Error("Trying to move organisms into population '", name,
+                           "' with the incorrect trait set.");
+      }
+      if (from_pop.data_layout_ptr && !data_layout_ptr) {
+        data_layout_ptr = from_pop.data_layout_ptr;
+        if (mirror_names.size()) ResolveMirrors();
+        if (track_names.size()) ResolveTracked();
+      }
+
+      std::swap(orgs, from_pop.orgs);
+      std::swap(living_pos, from_pop.living_pos);
+      std::swap(living_index, from_pop.living_index);
+      std::swap(num_orgs, from_pop.num_orgs);
+      for (size_t pos : living_pos) {
+        orgs[pos]->SetPopulation(*this);
+        orgs[pos]->SetTraitTracker(nullptr, 0);
+        AttachTracker(*orgs[pos], pos);
+      }
+
+      // The other population should now only have empty cells; remove them.
+      from_pop.orgs.resize(0);
+      from_pop.living_index.resize(0);
+      org_version++;
+      from_pop.org_version++;
+      trait_tracker.MarkAll();
+      from_pop.trait_tracker.MarkAll();
+    }
+
     /// Add an empty position to the end of the population (and return an iterator to it)
     iterator_t PushEmpty() {
       emp_assert(!empty_org.IsNull(),
                  "Population can only PushEmpty() if empty_org is provided.");
       size_t pos = orgs.size();
       orgs.resize(orgs.size()+1, empty_org);
+      living_index.push_back(NO_INDEX);
+      org_version++;
+      trait_tracker.MarkAll();
       return iterator_t(this, pos);
     }
 
@@ -235,6 +429,17 @@ namespace mabe {
                              "Return the capacity of the population.");
       info.AddMemberFunction("PTR", [](Population & target) { return (size_t) &target; },
                              "DEBUG: Give memory location of target.");
+      info.AddMemberFunction("MIRROR_TRAIT",
+                             [](Population & target, const std::string & trait_name) {
+                               target.MirrorTrait(trait_name); return 0;
+                             },
+                             "Keep a contiguous copy of a numeric trait to speed up summaries.");
+      info.AddMemberFunction("TRACK_TRAIT",
+                             [](Population & target, const std::string & trait_name) {
+                               target.TrackTrait(trait_name); return 0;
+                             },
+                             "Keep running statistics for a trait (numeric, or string such as a\n"
+                             "genome), updated only as organisms change.");
     }
 
 
@@ -281,6 +486,23 @@ namespace mabe {
           return false;
       }
 
+      // The living-position index should exactly match the occupied positions.
+      if (living_pos.size() != num_orgs || living_index.size() != orgs.size()) {
+        std::cerr << "ERROR: Population " << pop_id << " living index tracks "
+                  << living_pos.size() << " orgs over " << living_index.size()
+                  << " positions, but expected " << num_orgs << " orgs over " << orgs.size()
+                  << " positions." << std::endl;
+        return false;
+      }
+      for (size_t id = 0; id < living_pos.size(); id++) {
+        const size_t pos = living_pos[id];
+        if (pos >= orgs.size() || living_index[pos] != id || orgs[pos]->IsEmpty()) {
+          std::cerr << "ERROR: Population " << pop_id << " living index entry " << id
+                    << " (position " << pos << ") is inconsistent." << std::endl;
+          return false;
+        }
+      }
+
       // @CAO: If we have a cap on the population size, make sure we haven't crossed it?
 
       return true;
@@ -0,0 +1,166 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  Profiler.hpp
+ *  @brief Opt-in timing of signals and scripted calls, broken down by module.
+ *
+ *  The profiler is owned by the MABE controller and is inactive by default; when inactive,
+ *  starting a timer costs a single flag check.  Once activated (e.g., with --profile), every
+ *  signal trigger and instrumented script call (EVAL, SELECT, SCHEDULE, ...) records a call
+ *  count, total and maximum wall-clock time, and the number of organisms allocated from the
+ *  heap while it ran.  Times and allocation counts are inclusive of any nested calls.
+ *
+ *  Profiling assumes calls are made from the main thread; work done inside parallel loops is
+ *  attributed to the call that started the loop.
+ */
+
+#ifndef MABE_PROFILER_H
+#define MABE_PROFILER_H
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "emp/base/notify.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+
+namespace mabe {
+
+  class Profiler {
+  public:
+    using clock_t = std::chrono::steady_clock;
+
+    /// All of the information collected about a single (module, event) pair.
+    struct Entry {
+      std::string module;     ///< Name of the module being timed.
+      std::string event;      ///< Name of the signal or script function being timed.
+      size_t count = 0;       ///< How many times has this event run?
+      double total_time = 0;  ///< Total wall-clock time (in seconds) across all runs.
+      double max_time = 0;    ///< Longest single run (in seconds).
+      size_t num_allocs = 0;  ///< Organisms allocated from the heap during these runs.
+    };
+
+    /// A Timer records into its entry when stopped or destroyed; default Timers do nothing.
+    class Timer {
+    private:
+      emp::Ptr<Profiler> profiler = nullptr;
+      emp::Ptr<Entry> entry = nullptr;
+      clock_t::time_point start_time;
+      size_t start_allocs = 0;
+
+    public:
+      Timer() = default;
+      Timer(Profiler & in_profiler, Entry & in_entry)
+        : profiler(&in_profiler), entry(&in_entry)
+        , start_time(clock_t::now()), start_allocs(in_profiler.num_allocs) { }
+      Timer(const Timer &) = delete;
+      Timer(Timer && in) : profiler(in.profiler), entry(in.entry)
+        , start_time(in.start_time), start_allocs(in.start_allocs) { in.entry = nullptr; }
+      Timer & operator=(const Timer &) = delete;
+      Timer & operator=(Timer &&) = delete;
+      ~Timer() { Stop(); }
+
+      /// Record the time since this timer was started; later calls do nothing.
+      void Stop() {
+        if (!entry) return;
+        const double time = std::chrono::duration<double>(clock_t::now() - start_time).count();
+        entry->count++;
+        entry->total_time += time;
+        entry->max_time = std::max(entry->max_time, time);
+        entry->num_allocs += profiler->num_allocs - start_allocs;
+        entry = nullptr;
+      }
+    };
+
+  private:
+    bool active = false;                     ///< Should calls be timed?
+    std::string filename = "profile.csv";    ///< Where should results be saved at exit?
+    size_t num_allocs = 0;                   ///< Total organism allocations while active.
+
+    /// All entries, keyed by (module, event); map nodes are stable so entries can be cached.
+    std::map<std::pair<std::string,std::string>, Entry> entries;
+
+    /// Get entries sorted by total time, most expensive first.
+    emp::vector<emp::Ptr<const Entry>> GetSortedEntries() const {
+      emp::vector<emp::Ptr<const Entry>> out;
+      for (const auto & [key, entry] : entries) out.push_back(&entry);
+      std::stable_sort(out.begin(), out.end(),
+        [](emp::Ptr<const Entry> a, emp::Ptr<const Entry> b){ return a->total_time > b->total_time; });
+      return out;
+    }
+
+  public:
+    bool IsActive() const noexcept { return active; }
+    const std::string & GetFilename() const { return filename; }
+    size_t GetNumEntries() const { return entries.size(); }
+
+    void SetActive(bool in=true) { active = in; }
+    void SetFilename(const std::string & in) { filename = in; }
+
+    /// Note that an organism was allocated on the heap.
+    void CountAlloc() { if (active) num_allocs++; }
+
+    /// Find (or create) the entry associated with a module and event.
+    Entry & GetEntry(const std::string & module, const std::string & event) {
+      auto [it, is_new] = entries.try_emplace(std::make_pair(module, event));
+      if (is_new) {
+        it->second.module = module;
+        it->second.event = event;
+      }
+      return it->second;
+    }
+
+    /// Start timing an event; the returned timer records the results when it goes out of scope.
+    Timer StartTimer(const std::string & module, const std::string & event) {
+      if (!active) return Timer();
+      return Timer(*this, GetEntry(module, event));
+    }
+
+    /// Remove all collected results (cached entry pointers become invalid).
+    void Reset() { entries.clear(); num_allocs = 0; }
+
+    /// Print a human-readable table of results.
+    void PrintReport(std::ostream & os=std::cout) const {
+      os << std::left << std::setw(24) << "module" << std::setw(24) << "event"
+         << std::right << std::setw(12) << "count" << std::setw(14) << "total_ms"
+         << std::setw(12) << "max_ms" << std::setw(12) << "allocs" << "\n";
+      for (emp::Ptr<const Entry> entry : GetSortedEntries()) {
+        os << std::left << std::setw(24) << entry->module << std::setw(24) << entry->event
+           << std::right << std::setw(12) << entry->count
+           << std::setw(14) << std::fixed << std::setprecision(3) << entry->total_time * 1000.0
+           << std::setw(12) << entry->max_time * 1000.0
+           << std::setw(12) << entry->num_allocs << "\n";
+      }
+      os.flush();
+    }
+
+    /// Save all results as CSV.
+    void WriteCSV(const std::string & out_filename) const {
+      std::ofstream file(out_filename);
+      if (!file) {
+        emp::notify::Warning("Unable to open profile file '", out_filename, "'.");
+        return;
+      }
+      file << "module,event,count,total_time,max_time,allocs\n";
+      file << std::setprecision(9);
+      for (emp::Ptr<const Entry> entry : GetSortedEntries()) {
+        file << entry->module << ',' << entry->event << ',' << entry->count << ','
+             << entry->total_time << ',' << entry->max_time << ',' << entry->num_allocs << '\n';
+      }
+    }
+
+    /// Save all results to the default filename.
+    void WriteCSV() const { WriteCSV(filename); }
+  };
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  QuantileSketch.hpp
+ *  @brief Approximate quantiles of a stream of values in bounded memory (KLL sketch).
+ *
+ *  A QuantileSketch keeps a stack of "compactors", each holding values that stand in for 2^h
+ *  original values at level h.  When a compactor is full it is sorted and every other value
+ *  (starting at a random offset) is promoted to the next level, halving its size.  Capacities
+ *  shrink geometrically (by a factor of 2/3) toward the lower levels, so memory stays near 3k
+ *  values no matter how many are inserted, and the rank error of any quantile is O(1/k) of the
+ *  number of values (about 1% for the default k=200).
+ *
+ *  Compaction offsets come from a RandomStream with a fixed key, so the same values inserted in
+ *  the same order always produce the same estimates.  The exact minimum and maximum are also
+ *  kept, so extreme quantiles never fall outside the range of inserted values.  NaN values are
+ *  ignored.
+ *
+ *  Reference: Karnin, Lang, and Liberty (2016) "Optimal Quantile Approximation in Streams."
+ */
+
+#ifndef MABE_QUANTILE_SKETCH_H
+#define MABE_QUANTILE_SKETCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include "RandomStream.hpp"
+
+namespace mabe {
+
+  class QuantileSketch {
+  private:
+    static constexpr double SHRINK = 2.0 / 3.0;   ///< Capacity ratio between adjacent levels.
+    static constexpr size_t MIN_CAPACITY = 2;
+
+    size_t k;                                      ///< Capacity of the top level.
+    emp::vector<emp::vector<double>> compactors;   ///< Values held at each level.
+    size_t num_held = 0;                           ///< Values held across all levels.
+    size_t max_held = 0;                           ///< Compress when num_held reaches this.
+    size_t num_inserted = 0;                       ///< Total (non-NaN) values inserted.
+    double min_value = std::numeric_limits<double>::max();
+    double max_value = std::numeric_limits<double>::lowest();
+    RandomStream random;                           ///< Source of compaction offsets.
+
+    /// Most values that level h should hold (higher levels may hold more).
+    size_t Capacity(size_t level) const {
+      const size_t depth = compactors.size() - level - 1;
+      const size_t cap = (size_t) std::ceil(std::pow(SHRINK, (double) depth) * (double) k);
+      return std::max(cap, MIN_CAPACITY);
+    }
+
+    void Grow() {
+      compactors.emplace_back();
+      max_held = 0;
+      for (size_t level = 0; level < compactors.size(); ++level) max_held += Capacity(level);
+    }
+
+    /// Halve the lowest full compactor, promoting half of its values one level up.
+    void Compress() {
+      for (size_t level = 0; level < compactors.size(); ++level) {
+        if (compactors[level].size() < Capacity(level)) continue;
+        if (level + 1 == compactors.size()) Grow();
+
+        emp::vector<double> & cur = compactors[level];
+        emp::vector<double> & next = compactors[level+1];
+        std::sort(cur.begin(), cur.end());
+
+        // Keep an odd value out at this level, so that promoted values represent pairs.
+        const bool keep_last = cur.size() % 2;
+        const double last = keep_last ? cur.back() : 0.0;
+        if (keep_last) cur.pop_back();
+
+        const size_t offset = random.GetUInt64() & 1;
+        for (size_t i = offset; i < cur.size(); i += 2) next.push_back(cur[i]);
+        num_held -= cur.size() / 2;
+
+        cur.resize(0);
+        if (keep_last) cur.push_back(last);
+        return;
+      }
+    }
+
+  public:
+    static constexpr size_t DEFAULT_K = 200;
+    static constexpr uint64_t DEFAULT_KEY = 0x4B4C4C5F534B4554ull;
+
+    QuantileSketch(size_t in_k=DEFAULT_K, uint64_t random_key=DEFAULT_KEY)
+      : k(std::max(in_k, MIN_CAPACITY)), random(random_key) { Grow(); }
+
+    /// Number of values inserted (not counting NaNs).
+    size_t GetCount() const { return num_inserted; }
+
+    /// Number of values currently held in memory.
+    size_t GetNumHeld() const { return num_held; }
+
+    void Insert(double value) {
+      if (std::isnan(value)) return;
+      if (value < min_value) min_value = value;
+      if (value > max_value) max_value = value;
+      compactors[0].push_back(value);
+      ++num_held;
+      ++num_inserted;
+      if (num_held >= max_held) Compress();
+    }
+
+    /// Estimate the value at quantile q (0.0 to 1.0), using the same ranking as an exact
+    /// quantile of sorted values: the value at index floor(q * N).  Return NaN if empty.
+    double GetQuantile(double q) const {
+      if (num_inserted == 0) return std::numeric_limits<double>::quiet_NaN();
+      q = std::clamp(q, 0.0, 1.0);
+      if (q * (double) num_inserted < 1.0) return min_value;
+
+      // Pair each held value with the number of original values it stands for.
+      emp::vector<std::pair<double, size_t>> weighted;
+      weighted.reserve(num_held);
+      for (size_t level = 0; level < compactors.size(); ++level) {
+        for (double value : compactors[level]) weighted.emplace_back(value, ((size_t) 1) << level);
+      }
+      std::sort(weighted.begin(), weighted.end());
+
+      size_t total = 0;
+      for (const auto & entry : weighted) total += entry.second;
+      const double target = q * (double) total;
+
+      size_t cumulative = 0;
+      for (const auto & [value, weight] : weighted) {
+        cumulative += weight;
+        if ((double) cumulative > target) return value;
+      }
+      return max_value;
+    }
+
+    /// Remove all values (keeping the same random key).
+    void Clear() {
+      compactors.resize(0);
+      num_held = num_inserted = 0;
+      min_value = std::numeric_limits<double>::max();
+      max_value = std::numeric_limits<double>::lowest();
+      random.SetCounter(0);
+      Grow();
+    }
+  };
+
+}
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  RandomStream.hpp
+ *  @brief Counter-based random number streams for reproducible parallel work.
+ *
+ *  A RandomStream is identified by a 64-bit key (normally mixed from the run's random seed and
+ *  a few identifiers, such as module, update, and organism); its i'th draw is a pure function
+ *  of (key, i).  Streams therefore share no state: any number can be used at once, on any
+ *  thread, and the same keys always reproduce the same values regardless of thread count or
+ *  the order that work is done in.
+ *
+ *  MABE::ParallelFor() seeds each chunk of work from a substream of a per-loop stream, and modules
+ *  can request their own streams with GetRandomStream().
+ *
+ *  Draws use the SplitMix64 output function applied to a Weyl sequence offset by the key.  This
+ *  is fast and statistically strong for simulation use, but is not cryptographically secure.
+ */
+
+#ifndef MABE_RANDOM_STREAM_H
+#define MABE_RANDOM_STREAM_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+
+#include "emp/base/assert.hpp"
+
+namespace mabe {
+
+  class RandomStream {
+  private:
+    uint64_t key = 0;      ///< Identifies this stream.
+    uint64_t counter = 0;  ///< Index of the next draw.
+
+    static constexpr uint64_t GOLDEN = 0x9E3779B97F4A7C15ull;
+
+    static constexpr uint64_t Finalize(uint64_t x) {
+      x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+      x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+      return x ^ (x >> 31);
+    }
+
+  public:
+    constexpr RandomStream(uint64_t in_key=0, uint64_t in_counter=0)
+      : key(in_key), counter(in_counter) { }
+
+    /// Combine a base key with any number of values into a new, well-distributed key.
+    static constexpr uint64_t MixKeys(uint64_t base, std::initializer_list<uint64_t> values) {
+      uint64_t x = base;
+      for (uint64_t val : values) {
+        x ^= val + GOLDEN + (x << 6) + (x >> 2);
+        x = Finalize(x);
+      }
+      return x;
+    }
+
+    /// Convert a name into a key that is stable across platforms and runs (FNV-1a).
+    static constexpr uint64_t HashName(std::string_view name) {
+      uint64_t hash = 0xCBF29CE484222325ull;
+      for (char c : name) {
+        hash ^= (uint8_t) c;
+        hash *= 0x100000001B3ull;
+      }
+      return hash;
+    }
+
+    /// The value of draw 'index' from the stream with the given key.
+    static constexpr uint64_t Draw(uint64_t key, uint64_t index) {
+      return Finalize(key + (index + 1) * GOLDEN);
+    }
+
+    uint64_t GetKey() const { return key; }
+    uint64_t GetCounter() const { return counter; }
+
+    /// Jump to a specific draw in this stream.
+    void SetCounter(uint64_t in) { counter = in; }
+
+    /// A new stream derived from this one (e.g., one per organism from a per-module stream).
+    RandomStream GetSubstream(uint64_t id) const { return RandomStream(MixKeys(key, {id})); }
+
+    /// Get the next 64 random bits.
+    uint64_t GetUInt64() { return Draw(key, counter++); }
+
+    /// A positive value usable as a seed for an emp::Random.
+    int GetSeed() { return 1 + (int) (GetUInt64() % 2147483646); }
+
+    /// A random double in [0, 1).
+    double GetDouble() { return (double) (GetUInt64() >> 11) * 0x1.0p-53; }
+
+    /// A random double in [0, max).
+    double GetDouble(double max) { return GetDouble() * max; }
+
+    /// A random double in [min, max).
+    double GetDouble(double min, double max) { return min + GetDouble() * (max - min); }
+
+    /// Full 128-bit product of two 64-bit values; returns the high half and sets lo to the low
+    /// half.  (Portable; no compiler-specific 128-bit types.)
+    static constexpr uint64_t MulHiLo(uint64_t a, uint64_t b, uint64_t & lo) {
+      const uint64_t a_lo = a & 0xFFFFFFFFull, a_hi = a >> 32;
+      const uint64_t b_lo = b & 0xFFFFFFFFull, b_hi = b >> 32;
+      const uint64_t lo_lo = a_lo * b_lo;
+      const uint64_t hi_lo = a_hi * b_lo;
+      const uint64_t lo_hi = a_lo * b_hi;
+      const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFull) + lo_hi;
+      lo = (cross << 32) | (lo_lo & 0xFFFFFFFFull);
+      return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+    }
+
+    /// A random integer in [0, max), without modulo bias (Lemire's multiply-shift with
+    /// rejection).  A division is only needed for the rare draws that may need rejecting.
+    uint64_t GetUInt(uint64_t max) {
+      uint64_t lo = 0;
+      uint64_t result = MulHiLo(GetUInt64(), max, lo);
+      if (lo < max) {
+        const uint64_t threshold = (0 - max) % max;  // 2^64 mod max
+        while (lo < threshold) result = MulHiLo(GetUInt64(), max, lo);
+      }
+      return result;
+    }
+
+    /// A random integer in [min, max).
+    uint64_t GetUInt(uint64_t min, uint64_t max) {
+      emp_assert(min <= max, min, max);
+      return min + GetUInt(max - min);
+    }
+
+    /// Return true with the given probability.
+    bool P(double prob) { return GetDouble() < prob; }
+  };
+
+}
+
+#endif
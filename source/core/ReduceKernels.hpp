@@ -0,0 +1,198 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  ReduceKernels.hpp
+ *  @brief Fast, reproducible reductions (sum, min, max, entropy) over contiguous doubles.
+ *
+ *  Sums are computed in a fixed order that does not depend on the instruction set or on the
+ *  number of threads: values are split into blocks of BLOCK_SIZE; within a block, eight lane
+ *  accumulators each sum every eighth value and are combined as a balanced tree; block totals
+ *  are then combined pairwise.  SIMD versions (AVX or SSE2, if enabled at compile time) follow
+ *  exactly the same order as the scalar fallback, so all builds produce identical results, and
+ *  the pairwise structure keeps rounding error low for large populations.
+ *
+ *  Large inputs are split across a thread pool (if one has been provided with SetThreadPool());
+ *  each block's total is computed independently, so thread count does not affect results.
+ */
+
+#ifndef MABE_REDUCE_KERNELS_H
+#define MABE_REDUCE_KERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+
+#include "ThreadPool.hpp"
+
+namespace mabe {
+namespace Reduce {
+
+  constexpr size_t LANES = 8;                  ///< Independent accumulators per block.
+  constexpr size_t BLOCK_SIZE = 1024;          ///< Values summed together before combining.
+  constexpr size_t BLOCKS_PER_CHUNK = 16;      ///< Blocks given to a thread at a time.
+  constexpr size_t MIN_PARALLEL = 1 << 16;     ///< Smallest input worth splitting across threads.
+
+  /// Thread pool to use for large reductions (owned elsewhere; nullptr for serial only).
+  inline emp::Ptr<ThreadPool> & ThreadPoolPtr() {
+    static emp::Ptr<ThreadPool> pool_ptr = nullptr;
+    return pool_ptr;
+  }
+  inline void SetThreadPool(emp::Ptr<ThreadPool> in_pool) { ThreadPoolPtr() = in_pool; }
+
+  /// Run fun(start_block, end_block) over all blocks, in parallel if worthwhile.
+  template <typename FUN_T>
+  void ForEachBlock(size_t num_values, size_t num_blocks, FUN_T fun) {
+    emp::Ptr<ThreadPool> pool = ThreadPoolPtr();
+    if (pool && num_values >= MIN_PARALLEL && pool->GetNumThreads() > 1 && !pool->IsBusy()) {
+      pool->ForEachChunk(num_blocks, BLOCKS_PER_CHUNK,
+        [&fun](size_t start, size_t end, size_t, size_t){ fun(start, end); });
+    }
+    else fun(0, num_blocks);
+  }
+
+  /// Combine partial sums as a balanced binary tree.
+  inline double CombinePairwise(const double * sums, size_t count) {
+    if (count == 0) return 0.0;
+    if (count == 1) return sums[0];
+    const size_t half = count / 2;
+    return CombinePairwise(sums, half) + CombinePairwise(sums + half, count - half);
+  }
+
+  inline double CombineLanes(const double * lanes) {
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+           ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+  }
+
+  /// Sum one block of values (or of squared deviations from center, if SQ_DEV).
+  template <bool SQ_DEV>
+  double SumBlock(const double * data, size_t count, double center) {
+    double lanes[LANES] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256d c = _mm256_set1_pd(center);
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    for (; i + LANES <= count; i += LANES) {
+      __m256d x0 = _mm256_loadu_pd(data + i);
+      __m256d x1 = _mm256_loadu_pd(data + i + 4);
+      if constexpr (SQ_DEV) {
+        x0 = _mm256_sub_pd(x0, c);  x0 = _mm256_mul_pd(x0, x0);
+        x1 = _mm256_sub_pd(x1, c);  x1 = _mm256_mul_pd(x1, x1);
+      }
+      acc0 = _mm256_add_pd(acc0, x0);
+      acc1 = _mm256_add_pd(acc1, x1);
+    }
+    _mm256_storeu_pd(lanes, acc0);
+    _mm256_storeu_pd(lanes + 4, acc1);
+#elif defined(__SSE2__)
+    const __m128d c = _mm_set1_pd(center);
+    __m128d acc[4] = { _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd() };
+    for (; i + LANES <= count; i += LANES) {
+      for (size_t j = 0; j < 4; ++j) {
+        __m128d x = _mm_loadu_pd(data + i + 2*j);
+        if constexpr (SQ_DEV) { x = _mm_sub_pd(x, c);  x = _mm_mul_pd(x, x); }
+        acc[j] = _mm_add_pd(acc[j], x);
+      }
+    }
+    for (size_t j = 0; j < 4; ++j) _mm_storeu_pd(lanes + 2*j, acc[j]);
+#endif
+
+    // Scalar version (and any remaining values), in the same order as above.
+    for (; i < count; ++i) {
+      double x = data[i];
+      if constexpr (SQ_DEV) { x -= center;  x *= x; }
+      lanes[i % LANES] += x;
+    }
+    return CombineLanes(lanes);
+  }
+
+  template <bool SQ_DEV>
+  double BlockedSum(std::span<const double> values, double center) {
+    const size_t num_blocks = (values.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    if (num_blocks <= 1) return SumBlock<SQ_DEV>(values.data(), values.size(), center);
+
+    emp::vector<double> block_sums(num_blocks);
+    ForEachBlock(values.size(), num_blocks, [&](size_t start, size_t end){
+      for (size_t block = start; block < end; ++block) {
+        const size_t offset = block * BLOCK_SIZE;
+        const size_t count = std::min(BLOCK_SIZE, values.size() - offset);
+        block_sums[block] = SumBlock<SQ_DEV>(values.data() + offset, count, center);
+      }
+    });
+    return CombinePairwise(block_sums.data(), num_blocks);
+  }
+
+  /// Total of all values.
+  inline double Sum(std::span<const double> values) { return BlockedSum<false>(values, 0.0); }
+
+  /// Total of (value - center)^2 across all values.
+  inline double SumSquaredDev(std::span<const double> values, double center) {
+    return BlockedSum<true>(values, center);
+  }
+
+  /// Smallest value, ignoring NaNs (numeric_limits<double>::max() if none).  SIMD min is
+  /// x < acc ? x : acc, matching a scalar "if (x < min) min = x" loop.
+  inline double Min(std::span<const double> values) {
+    double result = std::numeric_limits<double>::max();
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256d acc = _mm256_set1_pd(result);
+    for (; i + 4 <= values.size(); i += 4) acc = _mm256_min_pd(_mm256_loadu_pd(values.data() + i), acc);
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    for (double lane : lanes) if (lane < result) result = lane;
+#endif
+    for (; i < values.size(); ++i) if (values[i] < result) result = values[i];
+    return result;
+  }
+
+  /// Largest value, ignoring NaNs (numeric_limits<double>::lowest() if none).
+  inline double Max(std::span<const double> values) {
+    double result = std::numeric_limits<double>::lowest();
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256d acc = _mm256_set1_pd(result);
+    for (; i + 4 <= values.size(); i += 4) acc = _mm256_max_pd(_mm256_loadu_pd(values.data() + i), acc);
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    for (double lane : lanes) if (lane > result) result = lane;
+#endif
+    for (; i < values.size(); ++i) if (values[i] > result) result = values[i];
+    return result;
+  }
+
+  /// Shannon entropy (in bits) of the distribution of values.  Distinct values are counted by
+  /// sorting, and terms are added in increasing order of value (as when counting in a std::map).
+  /// Return false if values include NaN, which cannot be sorted.
+  inline bool Entropy(std::span<const double> values, double & result) {
+    thread_local emp::vector<double> sorted;
+    sorted.assign(values.begin(), values.end());
+    for (double val : sorted) if (std::isnan(val)) return false;
+    std::sort(sorted.begin(), sorted.end());
+
+    const double N = (double) sorted.size();
+    result = 0.0;
+    for (size_t start = 0; start < sorted.size(); ) {
+      size_t end = start + 1;
+      while (end < sorted.size() && !(sorted[start] < sorted[end])) ++end;
+      const double p = ((double) (end - start)) / N;
+      result -= p * std::log2(p);
+      start = end;
+    }
+    return true;
+  }
+
+}
+}
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  Serialize.hpp
+ *  @brief Helpers for reading and writing values in a compact binary format (for checkpoints).
+ *
+ *  BinaryWrite(os, value) and BinaryRead(is, value) handle trivially copyable values (written
+ *  as raw bytes), std::string, emp::BitVector, and emp::vector of any supported type (written
+ *  as a length followed by the contents).  IsBinarySerializable<T>() reports whether a type
+ *  is supported; pointers are never supported since they cannot be restored.
+ *
+ *  Data is written in native byte order, so files are only portable between matching systems.
+ */
+
+#ifndef MABE_SERIALIZE_H
+#define MABE_SERIALIZE_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/bits/BitVector.hpp"
+
+namespace mabe {
+
+  namespace internal {
+    template <typename T> struct is_emp_vector : std::false_type { };
+    template <typename T> struct is_emp_vector<emp::vector<T>> : std::true_type { };
+    template <typename T> struct is_emp_ptr : std::false_type { };
+    template <typename T> struct is_emp_ptr<emp::Ptr<T>> : std::true_type { };
+  }
+
+  /// Can values of type T be written as raw bytes and read back later?
+  template <typename T>
+  constexpr bool IsRawSerializable() {
+    return std::is_trivially_copyable<T>() && !std::is_pointer<T>() &&
+           !std::is_member_pointer<T>() && !internal::is_emp_ptr<T>();
+  }
+
+  /// Can values of type T be written with BinaryWrite() and read back with BinaryRead()?
+  template <typename T>
+  constexpr bool IsBinarySerializable() {
+    if constexpr (IsRawSerializable<T>()) return true;
+    else if constexpr (std::is_same<T, std::string>()) return true;
+    else if constexpr (std::is_same<T, emp::BitVector>()) return true;
+    else if constexpr (internal::is_emp_vector<T>()) {
+      return IsBinarySerializable<typename T::value_type>();
+    }
+    else return false;
+  }
+
+  /// Write a value into a binary stream.
+  template <typename T>
+  void BinaryWrite(std::ostream & os, const T & value) {
+    static_assert(IsBinarySerializable<T>(), "Type cannot be serialized.");
+    if constexpr (IsRawSerializable<T>()) {
+      os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+    else if constexpr (std::is_same<T, std::string>()) {
+      BinaryWrite<uint64_t>(os, value.size());
+      os.write(value.data(), (std::streamsize) value.size());
+    }
+    else if constexpr (std::is_same<T, emp::BitVector>()) {
+      BinaryWrite<uint64_t>(os, value.GetSize());
+      for (size_t i = 0; i < value.GetNumBytes(); ++i) BinaryWrite<uint8_t>(os, value.GetByte(i));
+    }
+    else {  // Must be a vector.
+      using value_t = typename T::value_type;
+      BinaryWrite<uint64_t>(os, value.size());
+      if constexpr (IsRawSerializable<value_t>() && !std::is_same<value_t, bool>()) {
+        os.write(reinterpret_cast<const char *>(value.data()),
+                 (std::streamsize) (value.size() * sizeof(value_t)));
+      } else {
+        for (const value_t & x : value) BinaryWrite<value_t>(os, x);
+      }
+    }
+  }
+
+  /// Read a value from a binary stream; return whether the read was successful.
+  template <typename T>
+  bool BinaryRead(std::istream & is, T & value) {
+    static_assert(IsBinarySerializable<T>(), "Type cannot be serialized.");
+    if constexpr (IsRawSerializable<T>()) {
+      is.read(reinterpret_cast<char *>(&value), sizeof(T));
+    }
+    else if constexpr (std::is_same<T, std::string>()) {
+      uint64_t size = 0;
+      if (!BinaryRead(is, size)) return false;
+      value.resize(size);
+      is.read(value.data(), (std::streamsize) size);
+    }
+    else if constexpr (std::is_same<T, emp::BitVector>()) {
+      uint64_t size = 0;
+      if (!BinaryRead(is, size)) return false;
+      value.Resize(size);
+      for (size_t i = 0; i < value.GetNumBytes(); ++i) {
+        uint8_t byte = 0;
+        if (!BinaryRead(is, byte)) return false;
+        value.SetByte(i, byte);
+      }
+    }
+    else {  // Must be a vector.
+      using value_t = typename T::value_type;
+      uint64_t size = 0;
+      if (!BinaryRead(is, size)) return false;
+      value.resize(size);
+      if constexpr (IsRawSerializable<value_t>() && !std::is_same<value_t, bool>()) {
+        is.read(reinterpret_cast<char *>(value.data()), (std::streamsize) (size * sizeof(value_t)));
+      } else {
+        for (size_t i = 0; i < size; ++i) {
+          value_t x;
+          if (!BinaryRead(is, x)) return false;
+          value[i] = x;
+        }
+      }
+    }
+    return (bool) is;
+  }
+
+  /// Read a value of a given type from a binary stream, returning it (or a default on failure).
+  template <typename T>
+  T BinaryRead(std::istream & is) {
+    T value{};
+    BinaryRead(is, value);
+    return value;
+  }
+
+}
+
+#endif
@@ -8,16 +8,22 @@
  *
  *  A SigListener tracks which Modules respond to a specific signal.  They maintain pointers
  *  to modules and call them when requested.  The base class manages common functionality.
+ *
+ *  If a profiler is attached, each module's response to a signal is timed individually.
  */
 
 #ifndef MABE_SIGNAL_LISTENER_H
 #define MABE_SIGNAL_LISTENER_H
 
+#include <map>
+#include <string>
+
 #include "emp/base/array.hpp"
 #include "emp/base/Ptr.hpp"
 #include "emp/base/vector.hpp"
 
 #include "OrgIterator.hpp"
+#include "Profiler.hpp"
 
 namespace mabe {
 
@@ -29,6 +35,10 @@ namespace mabe {
     std::string name;          ///< Name of this signal type.
     id_t id;   ///< ID of this signal
     mod_ptr_t cur_mod;         ///< Which module is currently running?
+    emp::Ptr<Profiler> profiler = nullptr;  ///< Profiler to record into (null if not profiling)
+
+    /// Profile entries already looked up for each module.
+    std::map<mod_ptr_t, emp::Ptr<Profiler::Entry>> profile_entries;
 
     SigListenerBase(const std::string & _name="",
                     id_t _id=MODULE_T::SIG_UNKNOWN)
@@ -37,6 +47,19 @@ namespace mabe {
     SigListenerBase(SigListenerBase &&) = default;
     SigListenerBase & operator=(const SigListenerBase &) = default;
     SigListenerBase & operator=(SigListenerBase &&) = default;
+
+    /// Attach a profiler to time each module's response (or nullptr to stop profiling).
+    void SetProfiler(emp::Ptr<Profiler> in_profiler) {
+      profiler = in_profiler;
+      profile_entries.clear();
+    }
+
+    /// Start timing the provided module's response to this signal.
+    Profiler::Timer StartProfile(mod_ptr_t mod_ptr) {
+      emp::Ptr<Profiler::Entry> & entry = profile_entries[mod_ptr];
+      if (!entry) entry = &profiler->GetEntry(mod_ptr->GetName(), name);
+      return Profiler::Timer(*profiler, *entry);
+    }
   };
 
   /// Each set of modules to be called when a specific signal is triggered should be identified
@@ -65,9 +88,26 @@ namespace mabe {
 
     template <typename... ARGS2>
     void Trigger(ARGS2 &&... args) {
+      if (this->empty()) return;
+      if (base_t::profiler) {
+        TriggerProfiled(std::forward<ARGS2>(args)...);
+        return;
+      }
+      for (mod_ptr_t mod_ptr : *this) {
+        base_t::cur_mod = mod_ptr;
+        emp_assert(!mod_ptr.IsNull());
+        (mod_ptr.Raw()->*fun)( std::forward<ARGS2>(args)... );
+      }
+      base_t::cur_mod = nullptr;
+    }
+
+    /// Same as Trigger, but time each module's response.
+    template <typename... ARGS2>
+    void TriggerProfiled(ARGS2 &&... args) {
       for (mod_ptr_t mod_ptr : *this) {
         base_t::cur_mod = mod_ptr;
         emp_assert(!mod_ptr.IsNull());
+        Profiler::Timer timer = base_t::StartProfile(mod_ptr);
         (mod_ptr.Raw()->*fun)( std::forward<ARGS2>(args)... );
       }
       base_t::cur_mod = nullptr;
@@ -0,0 +1,233 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  SummaryPlanner.hpp
+ *  @brief Computes many population summaries (CALC_MEAN, CALC_MAX, ...) in a single pass.
+ *
+ *  Data files typically have many columns, each summarizing a trait (or equation) over the same
+ *  population.  Computed separately, every column is another pass over all organisms and their
+ *  DataMaps.  A SummaryPlanner instead collects all summary requests for one data layout; the
+ *  first time any of them is needed, a single pass over the population evaluates every
+ *  requested equation for each organism, storing the values contiguously.  Each request's
+ *  DataCollect function then runs over those values, so results are identical to summarizing
+ *  the population directly.  Columns with a batch function (such as a compiled trait equation)
+ *  are filled in a single call instead.  Results are kept separately for each population using
+ *  the layout, and are reused until that population changes or any organism trait is written
+ *  (see Organism::NoteTraitWrite()).
+ *
+ *  To avoid computing summaries that are no longer being used, a pass computes only requests
+ *  that were used since the previous pass (plus the one that triggered it).  If another request
+ *  is needed before anything changes, one more pass computes all remaining requests.
+ */
+
+#ifndef MABE_SUMMARY_PLANNER_H
+#define MABE_SUMMARY_PLANNER_H
+
+#include <functional>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+
+#include "Emplode/Symbol.hpp"
+
+#include "Organism.hpp"
+#include "Population.hpp"
+#include "TraitColumns.hpp"
+
+namespace mabe {
+
+  class SummaryPlanner {
+  public:
+    using Symbol_Var = emplode::Symbol_Var;
+
+    /// Values of one equation for every position in a population.  It provides the same
+    /// container interface as a Collection of that population (size, At, begin/end).
+    class ValueList {
+    private:
+      emp::Ptr<const emp::vector<double>> values = nullptr;
+    public:
+      ValueList(const emp::vector<double> & in) : values(&in) { }
+      size_t size() const { return values->size(); }
+      double At(size_t id) const { return (*values)[id]; }
+      std::span<const double> GetSpan() const { return {values->data(), values->size()}; }
+      auto begin() const { return values->begin(); }
+      auto end() const { return values->end(); }
+    };
+
+    using value_fun_t = std::function<double(const Organism &)>;
+    using batch_fun_t = std::function<void(const Population &, emp::vector<double> &)>;
+    using summary_fun_t = std::function<Symbol_Var(const ValueList &)>;
+
+  private:
+    static constexpr size_t NO_VERSION = (size_t) -1;
+
+    struct Column {
+      value_fun_t get_fun;          ///< Calculates this equation for an organism.
+      batch_fun_t batch_fun;        ///< Calculates it for a whole population (optional).
+      size_t num_requests = 0;      ///< How many requests use this column?
+    };
+
+    struct Request {
+      std::string equation;         ///< Which column does this request summarize?
+      summary_fun_t summary_fun;    ///< DataCollect function to apply to the column.
+    };
+
+    /// Values of one column for a particular population.
+    struct ColumnValues {
+      emp::vector<double> values;   ///< Results from the most recent pass.
+      bool is_current = false;      ///< Are values valid for the current population state?
+    };
+
+    /// Result of one request for a particular population.
+    struct RequestResult {
+      Symbol_Var result;            ///< Result from the most recent pass.
+      bool is_current = false;      ///< Is result valid for the current population state?
+      bool used_this_cycle = false; ///< Requested since the last change?
+      bool used_last_cycle = false; ///< Requested before the last change?
+    };
+
+    /// Cached results for one population, and its state when they were computed.
+    struct PopCache {
+      std::unordered_map<std::string, ColumnValues> columns;  ///< Keyed by equation.
+      emp::vector<RequestResult> requests;                    ///< Indexed by request ID.
+      size_t synced_version = NO_VERSION;
+      size_t synced_epoch = NO_VERSION;
+      size_t synced_defs = NO_VERSION;
+    };
+
+    std::unordered_map<std::string, Column> columns;  ///< Keyed by equation.
+    emp::vector<Request> requests;
+    std::unordered_map<std::string, size_t> request_ids;
+    size_t def_version = 0;        ///< Incremented whenever requests are added or replaced.
+
+    std::unordered_map<const Population *, PopCache> pop_caches;  ///< Results for each population.
+
+    void ReleaseColumn(const std::string & equation) {
+      auto it = columns.find(equation);
+      emp_assert(it != columns.end(), equation);
+      if (--it->second.num_requests == 0) columns.erase(it);
+    }
+
+    /// Fill in the columns for the given requests in one pass over the population, then
+    /// summarize each.
+    template <typename FILTER_T>
+    void RunPass(const Population & pop, PopCache & cache, FILTER_T use_request) {
+      emp::vector<std::pair<emp::Ptr<const Column>, emp::Ptr<ColumnValues>>> pass_columns;
+      for (size_t id = 0; id < requests.size(); ++id) {
+        if (cache.requests[id].is_current || !use_request(id)) continue;
+        const std::string & equation = requests[id].equation;
+        ColumnValues & column_values = cache.columns[equation];
+        if (column_values.is_current) continue;
+        column_values.is_current = true;
+        const Column & column = columns.at(equation);
+        if (column.batch_fun) column.batch_fun(pop, column_values.values);
+        else {
+          column_values.values.resize(pop.GetSize());
+          pass_columns.emplace_back(&column, &column_values);
+        }
+      }
+
+      for (size_t pos = 0; pos < pop.GetSize(); ++pos) {
+        const Organism & org = pop[pos];
+        for (auto [column, column_values] : pass_columns) {
+          column_values->values[pos] = column->get_fun(org);
+        }
+      }
+
+      for (size_t id = 0; id < requests.size(); ++id) {
+        RequestResult & request = cache.requests[id];
+        if (request.is_current || !use_request(id)) continue;
+        const ColumnValues & column_values = cache.columns.at(requests[id].equation);
+        request.result = requests[id].summary_fun( ValueList(column_values.values) );
+        request.is_current = true;
+      }
+    }
+
+  public:
+    size_t GetNumRequests() const { return requests.size(); }
+    size_t GetNumColumns() const { return columns.size(); }
+    size_t GetNumPopulations() const { return pop_caches.size(); }
+
+    /// Add (or replace) a request, identified by a unique key; return its ID.
+    size_t AddRequest(const std::string & key, const std::string & equation,
+                      value_fun_t get_fun, summary_fun_t summary_fun,
+                      batch_fun_t batch_fun=nullptr) {
+      auto [id_it, is_new] = request_ids.emplace(key, requests.size());
+      if (is_new) requests.emplace_back();
+      else ReleaseColumn(requests[id_it->second].equation);
+
+      Column & column = columns[equation];
+      if (column.num_requests++ == 0) {
+        column.get_fun = get_fun;
+        column.batch_fun = batch_fun;
+      }
+
+      Request & request = requests[id_it->second];
+      request.equation = equation;
+      request.summary_fun = summary_fun;
+      ++def_version;
+      return id_it->second;
+    }
+
+    /// Get the result of a request for the given population.
+    Symbol_Var GetResult(const Population & pop, size_t request_id) {
+      emp_assert(request_id < requests.size(), request_id, requests.size());
+      PopCache & cache = pop_caches[&pop];
+
+      // If anything has changed, all results are out of date; start a new cycle.
+      const size_t epoch = TraitColumns::GetTraitEpoch();
+      const bool changed = cache.synced_version != pop.GetOrgVersion() ||
+                           cache.synced_epoch != epoch || cache.synced_defs != def_version;
+      if (changed) {
+        if (cache.synced_defs != def_version) {
+          // Drop values of equations no longer requested; make room for new requests.
+          std::erase_if(cache.columns, [this](const auto & entry){
+            return !columns.contains(entry.first);
+          });
+          cache.requests.resize(requests.size());
+        }
+        for (auto & [equation, column_values] : cache.columns) column_values.is_current = false;
+        for (RequestResult & request : cache.requests) {
+          request.is_current = false;
+          request.used_last_cycle = request.used_this_cycle;
+          request.used_this_cycle = false;
+        }
+        cache.synced_version = pop.GetOrgVersion();
+        cache.synced_epoch = epoch;
+        cache.synced_defs = def_version;
+      }
+      RequestResult & cur_request = cache.requests[request_id];
+      cur_request.used_this_cycle = true;
+
+      if (!cur_request.is_current) {
+        // First pass in a cycle only computes what was used last time; later passes do the rest.
+        if (changed) {
+          RunPass(pop, cache, [&cache, request_id](size_t id){
+            return cache.requests[id].used_last_cycle || id == request_id;
+          });
+        }
+        else RunPass(pop, cache, [](size_t){ return true; });
+      }
+
+      return cur_request.result;
+    }
+
+    /// Remove all requests.
+    void Clear() {
+      columns.clear();
+      requests.resize(0);
+      request_ids.clear();
+      pop_caches.clear();
+      ++def_version;
+    }
+  };
+
+}
+
+#endif
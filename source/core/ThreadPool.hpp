@@ -0,0 +1,151 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  ThreadPool.hpp
+ *  @brief A simple, persistent pool of worker threads for data-parallel loops.
+ *
+ *  The thread pool is owned by the MABE controller and shared by all modules.  Worker threads
+ *  are created once (when the number of threads is set) and then sleep until a job arrives,
+ *  so there is no thread-creation cost per parallel loop.  The calling thread always
+ *  participates in the work as thread 0; a pool with one thread never spawns any workers and
+ *  simply runs each job serially.
+ *
+ *  Work is divided into fixed-size chunks that threads claim dynamically.  Chunk boundaries
+ *  depend only on the number of items and the chunk size (never on the number of threads), so
+ *  any per-chunk state (such as a random number stream) is reproducible across thread counts.
+ */
+
+#ifndef MABE_THREAD_POOL_H
+#define MABE_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+namespace mabe {
+
+  class ThreadPool {
+  public:
+    /// A job is run once on each thread and is given the ID of the thread running it.
+    using job_t = std::function<void(size_t thread_id)>;
+
+    /// A chunk function processes items [start, end) as chunk number chunk_id.
+    using chunk_fun_t = std::function<void(size_t start, size_t end, size_t chunk_id, size_t thread_id)>;
+
+  private:
+    emp::vector<std::thread> workers;  ///< Threads beyond the caller (thread 0).
+    std::mutex mutex;                  ///< Protects all of the job-tracking state below.
+    std::condition_variable start_cv;  ///< Wake workers when a new job is posted.
+    std::condition_variable done_cv;   ///< Wake the caller when all workers are finished.
+    job_t job;                         ///< Current job to be run on all threads.
+    size_t job_count = 0;              ///< Number of jobs posted so far (used as a job ID).
+    size_t num_running = 0;            ///< Number of workers still running the current job.
+    bool stop = false;                 ///< Should worker threads exit?
+    std::atomic<bool> busy{false};     ///< Is a job currently running?
+
+    /// Main loop for each worker; last_job is the most recent job posted before it was started.
+    void WorkerLoop(size_t thread_id, size_t last_job) {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        start_cv.wait(lock, [this, last_job](){ return stop || job_count != last_job; });
+        if (stop) return;
+        last_job = job_count;
+        job_t cur_job = job;
+        lock.unlock();
+        cur_job(thread_id);
+        lock.lock();
+        if (--num_running == 0) done_cv.notify_one();
+      }
+    }
+
+    /// Signal all workers to exit and wait for them to do so.
+    void StopWorkers() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+      }
+      start_cv.notify_all();
+      for (std::thread & worker : workers) worker.join();
+      workers.resize(0);
+      stop = false;
+    }
+
+  public:
+    ThreadPool(size_t num_threads=1) { SetNumThreads(num_threads); }
+    ThreadPool(const ThreadPool &) = delete;
+    ~ThreadPool() { StopWorkers(); }
+
+    /// How many threads (including the calling thread) will run each job?
+    size_t GetNumThreads() const { return workers.size() + 1; }
+
+    /// Is a job currently running?  (Jobs cannot be nested, so code that may be called from
+    /// inside a job should check this before using the pool.)
+    bool IsBusy() const { return busy.load(std::memory_order_acquire); }
+
+    /// Change the number of threads in the pool; zero means "use all hardware threads".
+    void SetNumThreads(size_t num_threads) {
+      if (num_threads == 0) num_threads = std::thread::hardware_concurrency();
+      if (num_threads == 0) num_threads = 1;  // hardware_concurrency() is allowed to fail.
+      if (num_threads == GetNumThreads()) return;
+
+      StopWorkers();
+      for (size_t thread_id = 1; thread_id < num_threads; ++thread_id) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, thread_id, job_count);
+      }
+    }
+
+    /// Run the provided job once on every thread in the pool, returning once all are done.
+    void RunOnAll(job_t in_job) {
+      busy.store(true, std::memory_order_release);
+      if (workers.size() == 0) {
+        in_job(0);
+        busy.store(false, std::memory_order_release);
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        emp_assert(num_running == 0, "ThreadPool jobs cannot be nested.");
+        job = in_job;
+        num_running = workers.size();
+        ++job_count;
+      }
+      start_cv.notify_all();
+
+      in_job(0);  // The calling thread acts as thread 0.
+
+      std::unique_lock<std::mutex> lock(mutex);
+      done_cv.wait(lock, [this](){ return num_running == 0; });
+      job = nullptr;
+      busy.store(false, std::memory_order_release);
+    }
+
+    /// Split the range [0, num_items) into chunks of (at most) chunk_size items, and process
+    /// each chunk exactly once on whichever thread claims it first.
+    void ForEachChunk(size_t num_items, size_t chunk_size, chunk_fun_t fun) {
+      emp_assert(chunk_size > 0);
+      const size_t num_chunks = (num_items + chunk_size - 1) / chunk_size;
+      if (num_chunks == 0) return;
+
+      std::atomic<size_t> next_chunk{0};
+      RunOnAll([&](size_t thread_id){
+        for (size_t chunk_id = next_chunk++; chunk_id < num_chunks; chunk_id = next_chunk++) {
+          const size_t start = chunk_id * chunk_size;
+          const size_t end = std::min(start + chunk_size, num_items);
+          fun(start, end, chunk_id, thread_id);
+        }
+      });
+    }
+  };
+
+}
+
+#endif
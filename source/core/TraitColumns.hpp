@@ -0,0 +1,183 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  TraitColumns.hpp
+ *  @brief Contiguous, position-indexed copies of selected numeric traits for a population.
+ *
+ *  Each organism stores its traits in its own DataMap, so scanning one trait across a population
+ *  means following a pointer to every organism.  A TraitColumns object mirrors chosen numeric
+ *  traits as arrays of doubles (one entry per position, including empty cells, which hold the
+ *  empty organism's values) so that summaries can run as simple loops over contiguous memory
+ *  and match summaries of the full population.
+ *
+ *  Columns are kept current by their population's TraitTracker: positions that are marked dirty
+ *  (an organism was placed or removed, or one of its traits was written) are re-read when the
+ *  columns are next used, and everything is re-read only after the population is resized.
+ *
+ *  The global trait epoch advances after any organism trait is written (every write that marks
+ *  a TraitTracker position dirty also notes the change here); caches that are not maintained
+ *  by position (such as SummaryPlanner results) use it to decide when to recompute.
+ */
+
+#ifndef MABE_TRAIT_COLUMNS_H
+#define MABE_TRAIT_COLUMNS_H
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/data/DataLayout.hpp"
+#include "emp/meta/TypeID.hpp"
+
+namespace mabe {
+
+  class TraitColumns {
+  public:
+    /// A read-only view of one column, in position order.  It provides the container interface
+    /// used by DataCollect (size, At, begin/end).
+    class View {
+    private:
+      std::span<const double> values;
+
+    public:
+      View() = default;
+      View(std::span<const double> _v) : values(_v) { }
+
+      size_t size() const { return values.size(); }
+      double At(size_t id) const { return values[id]; }
+      auto begin() const { return values.begin(); }
+      auto end() const { return values.end(); }
+    };
+
+    /// How should values of a trait be converted to double?
+    enum class Kind { DOUBLE, FLOAT, INT, UINT64, INT64, UINT32, BOOL, UNKNOWN };
+
+    static Kind GetKind(emp::TypeID type) {
+      if (type == emp::GetTypeID<double>()) return Kind::DOUBLE;
+      if (type == emp::GetTypeID<float>()) return Kind::FLOAT;
+      if (type == emp::GetTypeID<int>()) return Kind::INT;
+      if (type == emp::GetTypeID<uint64_t>()) return Kind::UINT64;
+      if (type == emp::GetTypeID<int64_t>()) return Kind::INT64;
+      if (type == emp::GetTypeID<uint32_t>()) return Kind::UINT32;
+      if (type == emp::GetTypeID<bool>()) return Kind::BOOL;
+      return Kind::UNKNOWN;
+    }
+
+    /// Read a single trait value from an organism as a double.
+    template <typename ORG_T>
+    static double ReadValue(const ORG_T & org, size_t trait_id, Kind kind) {
+      switch (kind) {
+        case Kind::DOUBLE: return (double) org.template GetTrait<double>(trait_id);
+        case Kind::FLOAT:  return (double) org.template GetTrait<float>(trait_id);
+        case Kind::INT:    return (double) org.template GetTrait<int>(trait_id);
+        case Kind::UINT64: return (double) org.template GetTrait<uint64_t>(trait_id);
+        case Kind::INT64:  return (double) org.template GetTrait<int64_t>(trait_id);
+        case Kind::UINT32: return (double) org.template GetTrait<uint32_t>(trait_id);
+        case Kind::BOOL:   return (double) org.template GetTrait<bool>(trait_id);
+        case Kind::UNKNOWN: break;
+      }
+      emp_assert(false, "Trait cannot be read as a number.");
+      return 0.0;
+    }
+
+  private:
+    struct Column {
+      std::string name;
+      size_t trait_id;
+      Kind kind;
+      emp::vector<double> values;
+    };
+
+    emp::vector<Column> columns;
+
+    static inline std::atomic<size_t> trait_epoch{0};
+    static inline std::atomic<bool> traits_changed{false};  ///< Any writes since last epoch?
+
+  public:
+    /// Note that traits may have been changed, so caches based on the epoch must be refreshed.
+    /// Called on every trait write (possibly from many threads), so it only sets a flag, and
+    /// only if not already set; the epoch itself advances when it is next read.
+    static void NoteTraitChange() {
+      if (!traits_changed.load(std::memory_order_relaxed)) {
+        traits_changed.store(true, std::memory_order_relaxed);
+      }
+    }
+
+    /// Get the current trait epoch; if unchanged, no traits have been marked as modified.
+    static size_t GetTraitEpoch() {
+      if (traits_changed.exchange(false, std::memory_order_relaxed)) {
+        return trait_epoch.fetch_add(1, std::memory_order_relaxed) + 1;
+      }
+      return trait_epoch.load(std::memory_order_relaxed);
+    }
+
+    size_t GetNumColumns() const { return columns.size(); }
+
+    /// Is the trait with the given ID mirrored?
+    bool HasColumn(size_t trait_id) const {
+      for (const Column & col : columns) if (col.trait_id == trait_id) return true;
+      return false;
+    }
+
+    /// Can a trait be mirrored?  It must be a single value of a supported numeric type.
+    static bool CanMirror(const emp::DataLayout & layout, size_t trait_id) {
+      return layout.GetCount(trait_id) == 1 && GetKind(layout.GetType(trait_id)) != Kind::UNKNOWN;
+    }
+
+    /// Start mirroring a trait; return false if this trait type cannot be mirrored.  Values
+    /// are filled in by the next Rebuild().
+    bool AddColumn(const emp::DataLayout & layout, const std::string & name) {
+      if (!layout.HasName(name)) return false;
+      const size_t trait_id = layout.GetID(name);
+      if (HasColumn(trait_id)) return true;
+      if (!CanMirror(layout, trait_id)) return false;
+      columns.push_back(Column{name, trait_id, GetKind(layout.GetType(trait_id)), {}});
+      return true;
+    }
+
+    /// Re-read every position.  ORGS_T must be indexable by position, giving pointers to
+    /// organisms (empty cells included).
+    template <typename ORGS_T>
+    void Rebuild(const ORGS_T & orgs) {
+      for (Column & col : columns) {
+        col.values.resize(orgs.size());
+        for (size_t pos = 0; pos < orgs.size(); ++pos) {
+          col.values[pos] = ReadValue(*orgs[pos], col.trait_id, col.kind);
+        }
+      }
+    }
+
+    /// Re-read only the given positions (the population size must not have changed).
+    template <typename ORGS_T>
+    void Update(const ORGS_T & orgs, std::span<const size_t> positions) {
+      for (Column & col : columns) {
+        emp_assert(col.values.size() == orgs.size(), col.values.size(), orgs.size());
+        for (size_t pos : positions) {
+          col.values[pos] = ReadValue(*orgs[pos], col.trait_id, col.kind);
+        }
+      }
+    }
+
+    /// Get the values of a mirrored trait by position.
+    std::span<const double> GetValues(size_t trait_id) const {
+      for (const Column & col : columns) if (col.trait_id == trait_id) return col.values;
+      emp_assert(false, "Requested trait is not mirrored.", trait_id);
+      return {};
+    }
+
+    /// Get a view of a mirrored trait, for use with DataCollect.
+    View GetView(size_t trait_id) const { return View(GetValues(trait_id)); }
+
+    /// Stop mirroring all traits.
+    void Clear() { columns.resize(0); }
+  };
+
+}
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  TraitHandle.hpp
+ *  @brief Typed access to an organism trait, resolved once instead of looked up by name.
+ *
+ *  Modules often store trait names as configurable strings; calling org.GetTrait<T>(name) then
+ *  costs a hash lookup each time.  A TraitHandle keeps a reference to such a name variable and
+ *  is resolved to the trait's DataMap ID when the DataMap is locked (just before the module's
+ *  SetupDataMap() is called).  Afterwards, accesses go straight to the trait's memory; types
+ *  are only verified in debug builds.  Bool and double handles return reference-like objects
+ *  (see TraitStorage.hpp) so that traits with compact storage are handled transparently.
+ *  Non-const access notifies the organism's TraitTracker (if any) that the trait may change, so
+ *  code that only reads a trait should use Read().
+ *
+ *  Usage (inside a Module; the handle must be declared after the name it refers to):
+ *    std::string fitness_trait = "fitness";
+ *    TraitHandle<double> fitness_handle{this, fitness_trait};
+ *    ...
+ *    fitness_handle(org) += 1.0;
+ */
+
+#ifndef MABE_TRAIT_HANDLE_H
+#define MABE_TRAIT_HANDLE_H
+
+#include <string>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/notify.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/data/DataMap.hpp"
+
+#include "ModuleBase.hpp"
+#include "Organism.hpp"
+#include "TraitInfo.hpp"
+#include "TraitStorage.hpp"
+
+namespace mabe {
+
+  class TraitHandleBase {
+  protected:
+    emp::Ptr<const std::string> name_ptr;  ///< Trait name (may be changed by configuration).
+    TraitLocation location;                ///< Where this trait is stored, once resolved.
+
+  public:
+    TraitHandleBase(emp::Ptr<TraitHolder> holder, const std::string & name_var)
+      : name_ptr(&name_var)
+    {
+      emp_assert(holder);
+      holder->handle_ptrs.push_back(this);
+    }
+    TraitHandleBase(const TraitHandleBase &) = delete;
+    TraitHandleBase & operator=(const TraitHandleBase &) = delete;
+    virtual ~TraitHandleBase() { }
+
+    const std::string & GetName() const { return *name_ptr; }
+    size_t GetID() const { return location.id; }
+    bool IsResolved() const { return location.IsValid(); }
+
+    /// Find this trait in a locked DataMap; return false (and report an error) if not present.
+    /// The trait's info (if available) indicates how it is stored.
+    virtual bool Resolve(const emp::DataMap & dm, emp::Ptr<const TraitInfo> info_ptr) = 0;
+  };
+
+  template <typename T>
+  class TraitHandle : public TraitHandleBase {
+  public:
+    using TraitHandleBase::TraitHandleBase;
+
+    using ref_t = typename TraitRefType<T>::type;
+    using const_ref_t = typename TraitRefType<T>::const_type;
+
+    bool Resolve(const emp::DataMap & dm, emp::Ptr<const TraitInfo> info_ptr) override {
+      if (!location.Locate(dm, *name_ptr, info_ptr)) {
+        emp::notify::Error("Trait handle refers to unknown trait '", *name_ptr, "'.");
+        return false;
+      }
+      emp_assert(location.IsCompatible<T>(dm), "Trait handle type does not match trait.", *name_ptr);
+      return true;
+    }
+
+    /// Access a trait for writing; the organism is marked as modified.
+    ref_t Get(Organism & org) const {
+      emp_assert(IsResolved(), "Trait handle used before DataMap was set up.", *name_ptr);
+      org.NoteTraitWrite();
+      return location.Access<T>(org);
+    }
+    const_ref_t Get(const Organism & org) const {
+      emp_assert(IsResolved(), "Trait handle used before DataMap was set up.", *name_ptr);
+      return location.Access<T>(org);
+    }
+    void Set(Organism & org, const T & value) const { Get(org) = value; }
+
+    /// Read a trait without marking the organism as modified.
+    const_ref_t Read(const Organism & org) const { return Get(org); }
+
+    ref_t operator()(Organism & org) const { return Get(org); }
+    const_ref_t operator()(const Organism & org) const { return Get(org); }
+  };
+
+}
+
+#endif
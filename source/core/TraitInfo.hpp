@@ -40,6 +40,14 @@
  *
  *  The SUMMARY method determines how a trait should be summarized over a collection of organisms.
  *    [[[ needs refinement... ]]]
+ *
+ *  The STORAGE method describes how values are kept in each organism's DataMap.  Traits marked
+ *  as compact are converted when the DataMap is built:
+ *    [NATIVE]     - Stored as the declared type (the default).
+ *    [PACKED_BIT] - A single bool stored as one bit of a shared byte.
+ *    [FLOAT32]    - A double stored as a float (low precision, half the size).
+ *  Compact traits are only transparent when accessed through typed trait objects (OrgTrait or
+ *  TraitHandle), so compact storage is refused for any trait that a module uses by name.
  * 
  * 
  *  DEVELOPER NOTES:
@@ -52,13 +60,21 @@
 #ifndef MABE_TRAIT_INFO_H
 #define MABE_TRAIT_INFO_H
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
 #include <set>
 #include <string>
+#include <type_traits>
 
 #include "emp/base/vector.hpp"
 #include "emp/data/DataMap.hpp"
 #include "emp/meta/TypeID.hpp"
 
+#include "Serialize.hpp"
+
 namespace mabe {
 
   class ModuleBase;
@@ -124,6 +140,13 @@ namespace mabe {
       FULL,       ///< Store ALL current/final values for organisms.
     };
 
+    /// How are values of this trait stored in an organism's DataMap?
+    enum class Storage {
+      NATIVE=0,   ///< Stored as declared.
+      PACKED_BIT, ///< Bool stored as a single bit in a shared byte (see GetPackedWord()).
+      FLOAT32     ///< Double stored as a float.
+    };
+
     /// Special value count to represent ANY count is allowed.
     static constexpr const size_t ANY_COUNT = static_cast<size_t>(-1);
 
@@ -132,6 +155,11 @@ namespace mabe {
     bool reset_parent = false;  ///< Should the parent ALSO be reset on birth?
     Archive archive = Archive::NONE;
     Summary summary = Summary::IGNORE;
+    bool compact = false;               ///< Has compact storage been requested?
+    Storage storage = Storage::NATIVE;  ///< How is this trait actually stored?
+    std::string packed_word = "";       ///< For PACKED_BIT, the name of the shared word.
+    uint8_t packed_mask = 0;            ///< For PACKED_BIT, the bit used in the shared word.
+    emp::Ptr<TraitInfo> stored_info = nullptr;  ///< For FLOAT32, info for the stored floats.
 
     // Track which modules are using this trait and what access they need.
     using mod_ptr_t = emp::Ptr<ModuleBase>;
@@ -163,7 +191,10 @@ namespace mabe {
     }
 
   public:
-    virtual ~TraitInfo() { ; }
+    TraitInfo() = default;
+    TraitInfo(const TraitInfo &) = delete;
+    TraitInfo & operator=(const TraitInfo &) = delete;
+    virtual ~TraitInfo() { if (stored_info) stored_info.Delete(); }
 
     const std::string & GetName() const { return name; }
     const std::string & GetDesc() const { return desc; }
@@ -219,6 +250,14 @@ namespace mabe {
       return mod_names;
     }
 
+    emp::vector<mod_ptr_t> GetModules() const {
+      emp::vector<mod_ptr_t> mod_ptrs;
+      for (auto info : access_info) {
+        mod_ptrs.push_back(info.mod_ptr);
+      }
+      return mod_ptrs;
+    }
+
     emp::vector<std::string> GetModuleNames(Access test_access) const {
       emp::vector<std::string> mod_names;
       for (auto info : access_info) {
@@ -242,9 +281,24 @@ namespace mabe {
     Init GetInit() const { return init; }
     Archive GetArchive() const { return archive; }
     Summary GetSummary() const { return summary; }
+    bool IsCompact() const { return compact; }
+    Storage GetStorage() const { return storage; }
+    const std::string & GetPackedWord() const { return packed_word; }
+    uint8_t GetPackedMask() const { return packed_mask; }
 
     TraitInfo & SetName(const std::string & in_name) { name = in_name; return *this; }
     TraitInfo & SetDesc(const std::string & in_desc) { desc = in_desc; return *this; }
+
+    /// Request that this trait be stored compactly (bools as bits, doubles as floats).
+    TraitInfo & SetCompact(bool in=true) { compact = in; return *this; }
+
+    /// Store this (bool) trait as a bit in a shared word; it is no longer in the DataMap itself.
+    TraitInfo & SetPackedBit(const std::string & word, uint8_t mask) {
+      storage = Storage::PACKED_BIT;
+      packed_word = word;
+      packed_mask = mask;
+      return *this;
+    }
  
     /// Add a module that can access this trait.
     TraitInfo & AddAccess(const std::string & in_name, mod_ptr_t in_mod, Access access, bool is_manager) {
@@ -290,12 +344,47 @@ namespace mabe {
     
     /// Reset this trait back to its default value.
     virtual bool ResetToDefault(emp::DataMap &) { return false; }
+
+    /// Switch this trait to float storage; return false if it is not a double.
+    virtual bool SetFloat32() { return false; }
+
+    /// Number of bytes each organism uses to store this trait directly in its DataMap.
+    virtual size_t GetStorageSize() const { return 0; }
+
+    /// Reset all values of this trait (located by its ID in the DataMap) to the default.
+    virtual void ResetValues(emp::DataMap &, size_t /*id*/) const { }
+
+    /// If this trait's values can be safely copied with memcpy, return the number of bytes they
+    /// take up and a pointer to them in a DataMap; otherwise return 0 and nullptr.
+    virtual size_t GetTrivialSize() const { return 0; }
+    virtual std::byte * GetTrivialPtr(emp::DataMap &, size_t /*id*/) const { return nullptr; }
+
+    // --- Checkpointing: trait values are located by the ID of this trait in the DataMap ---
+
+    /// Can the values of this trait be saved as raw bytes?
+    virtual bool IsRawSerializable() const { return false; }
+
+    /// Can the values of this trait be saved at all?
+    virtual bool IsSerializable() const { return false; }
+
+    /// How many bytes do the raw values of this trait take? (0 if not raw serializable)
+    virtual size_t GetRawSize() const { return 0; }
+
+    /// Copy the raw values of this trait to/from a byte buffer.
+    virtual void CopyToRaw(const emp::DataMap &, size_t /*id*/, std::byte * /*out*/) const { }
+    virtual void CopyFromRaw(emp::DataMap &, size_t /*id*/, const std::byte * /*in*/) const { }
+
+    /// Write or read the values of this trait in binary; return false if not possible.
+    virtual bool SaveValue(std::ostream &, const emp::DataMap &, size_t /*id*/) const { return false; }
+    virtual bool LoadValue(std::istream &, emp::DataMap &, size_t /*id*/) const { return false; }
   };
 
   // Information about this trait, including type information and alternate type options.
   template <typename T>
   class TypedTraitInfo : public TraitInfo {
   private:
+    template <typename> friend class TypedTraitInfo;  // Allow conversion between storage types.
+
     T default_value;
     bool has_default;
 
@@ -326,6 +415,8 @@ namespace mabe {
     }
 
     bool ResetToDefault(emp::DataMap& dm) override {
+      if (storage == Storage::PACKED_BIT) return false;  // Reset through shared word.
+      if (stored_info) return stored_info->ResetToDefault(dm);
       emp_assert(dm.HasName(GetName()));
       emp_assert(dm.IsType<T>(GetName()));
 
@@ -334,12 +425,107 @@ namespace mabe {
       else val = { };
       return true;
     }
+
+    void ResetValues(emp::DataMap & dm, size_t id) const override {
+      if (stored_info) return stored_info->ResetValues(dm, id);
+      emp_assert(dm.IsType<T>(id), name);
+      T * values = &dm.Get<T>(id);
+      for (size_t i = 0; i < val_count; ++i) {
+        if (has_default) values[i] = default_value;
+        else values[i] = { };
+      }
+    }
+
+    size_t GetTrivialSize() const override {
+      if (stored_info) return stored_info->GetTrivialSize();
+      return std::is_trivially_copyable<T>() ? sizeof(T) * val_count : 0;
+    }
+
+    std::byte * GetTrivialPtr(emp::DataMap & dm, size_t id) const override {
+      if (stored_info) return stored_info->GetTrivialPtr(dm, id);
+      if constexpr (std::is_trivially_copyable<T>()) {
+        return reinterpret_cast<std::byte *>(&dm.Get<T>(id));
+      }
+      return nullptr;
+    }
     
     bool Register(emp::DataMap & dm) const override {
+      if (storage == Storage::PACKED_BIT) return false;  // Stored in a shared word.
+      if (stored_info) return stored_info->Register(dm);
       dm.AddVar(name, default_value, desc, "MABE Trait", val_count);
       return true;
     }
 
+    /// The trait keeps its declared type (and its place in the trait map, since modules hold
+    /// references to it); the DataMap-facing calls below forward to a float version.
+    bool SetFloat32() override {
+      if constexpr (std::is_same<T, double>()) {
+        if (stored_info) return true;
+        const float stored_default = has_default ? (float) default_value : 0.0f;
+        auto float_ptr = emp::NewPtr<TypedTraitInfo<float>>(name, stored_default, val_count);
+        float_ptr->SetDesc(desc);
+        float_ptr->storage = Storage::FLOAT32;
+        stored_info = float_ptr;
+        storage = Storage::FLOAT32;
+        return true;
+      }
+      return false;
+    }
+
+    size_t GetStorageSize() const override {
+      if (stored_info) return stored_info->GetStorageSize();
+      return (storage == Storage::PACKED_BIT) ? 0 : sizeof(T) * val_count;
+    }
+
+    bool IsRawSerializable() const override {
+      if (stored_info) return stored_info->IsRawSerializable();
+      return mabe::IsRawSerializable<T>();
+    }
+    bool IsSerializable() const override {
+      if (stored_info) return stored_info->IsSerializable();
+      return mabe::IsBinarySerializable<T>();
+    }
+    size_t GetRawSize() const override {
+      if (stored_info) return stored_info->GetRawSize();
+      return IsRawSerializable() ? sizeof(T) * val_count : 0;
+    }
+
+    void CopyToRaw(const emp::DataMap & dm, size_t id, std::byte * out) const override {
+      if (stored_info) return stored_info->CopyToRaw(dm, id, out);
+      if constexpr (mabe::IsRawSerializable<T>()) {
+        std::memcpy(out, &dm.Get<T>(id), sizeof(T) * val_count);
+      }
+    }
+
+    void CopyFromRaw(emp::DataMap & dm, size_t id, const std::byte * in) const override {
+      if (stored_info) return stored_info->CopyFromRaw(dm, id, in);
+      if constexpr (mabe::IsRawSerializable<T>()) {
+        std::memcpy(&dm.Get<T>(id), in, sizeof(T) * val_count);
+      }
+    }
+
+    bool SaveValue(std::ostream & os, const emp::DataMap & dm, size_t id) const override {
+      if (stored_info) return stored_info->SaveValue(os, dm, id);
+      if constexpr (mabe::IsBinarySerializable<T>()) {
+        const T * values = &dm.Get<T>(id);
+        for (size_t i = 0; i < val_count; ++i) BinaryWrite(os, values[i]);
+        return true;
+      }
+      return false;
+    }
+
+    bool LoadValue(std::istream & is, emp::DataMap & dm, size_t id) const override {
+      if (stored_info) return stored_info->LoadValue(is, dm, id);
+      if constexpr (mabe::IsBinarySerializable<T>()) {
+        T * values = &dm.Get<T>(id);
+        for (size_t i = 0; i < val_count; ++i) {
+          if (!BinaryRead(is, values[i])) return false;
+        }
+        return true;
+      }
+      return false;
+    }
+
   };
 
   // Information about a trait that is currently only accessed as a string.
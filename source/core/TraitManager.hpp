@@ -9,17 +9,36 @@
  *  A TraitManager facilitates the creation and destruction of TraitInfo object, which are
  *  stored in DataMaps and maintain access information about classes (modules) that use those
  *  traits.
+ *
+ *  Once the organism DataMap layout is locked, BuildResetImage() bakes the default values of
+ *  all traits into a byte image.  Resetting an organism's traits then copies the image over
+ *  each contiguous run of trivially-copyable traits, and only needs to individually assign
+ *  the (usually few) traits that manage their own memory, such as strings or vectors.
+ *
+ *  Traits can also be marked as compact (see TraitInfo::Storage); when the DataMap is built,
+ *  compact bools from all modules are packed together, eight per byte, into shared words
+ *  (named "_packed_bits_#"), and compact doubles are stored as floats.  Since only OrgTrait and
+ *  TraitHandle know how to reach compact storage, it is refused (with an error) for any trait
+ *  that a module accesses by name.
  */
 
 #ifndef MABE_TRAIT_MANAGER_HPP
 #define MABE_TRAIT_MANAGER_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 
 #include "emp/base/Ptr.hpp"
 #include "emp/meta/type_traits.hpp"
 #include "emp/base/notify.hpp"
+#include "emp/tools/string_utils.hpp"
 
 #include "TraitInfo.hpp"
 
@@ -42,6 +61,22 @@ namespace mabe {
     /// Count the total number of errors encountered.
     int error_count = 0;
 
+    /// A contiguous run of trivially-copyable trait values in a DataMap.
+    struct ResetBlock {
+      size_t offset;     ///< Start of block, in bytes from the reset anchor.
+      size_t size;       ///< Number of bytes in block.
+      size_t image_pos;  ///< Start of the default values for this block in reset_image.
+    };
+
+    /// Default trait values, baked once the DataMap layout is locked (see BuildResetImage).
+    bool has_reset_image = false;
+    emp::DataMap reset_map;                  ///< DataMap with every trait at its default.
+    emp::vector<std::byte> reset_image;      ///< Default bytes for all trivial traits.
+    emp::vector<ResetBlock> reset_blocks;    ///< Where to copy reset_image into a DataMap.
+    emp::Ptr<TraitInfo> reset_anchor;        ///< Trait used to locate blocks in a DataMap.
+    size_t reset_anchor_id = 0;              ///< DataMap ID of the anchor trait.
+    emp::vector<std::pair<emp::Ptr<TraitInfo>, size_t>> reset_nontrivial; ///< Traits & IDs
+
   public:
     TraitManager() { }
     ~TraitManager() {
@@ -52,19 +87,185 @@ namespace mabe {
 
     size_t GetSize() const { return trait_map.size(); }
 
+    /// Get information about a trait (or nullptr if no such trait exists).
+    emp::Ptr<TraitInfo> GetTraitInfo(const std::string & trait_name) const {
+      auto it = trait_map.find(trait_name);
+      return (it == trait_map.end()) ? nullptr : it->second;
+    }
+
+    /// Get information about all traits, sorted by name for a consistent ordering.
+    emp::vector<emp::Ptr<TraitInfo>> GetTraits() const {
+      emp::vector<emp::Ptr<TraitInfo>> traits;
+      for (auto [name,trait_ptr] : trait_map) traits.push_back(trait_ptr);
+      std::sort(traits.begin(), traits.end(),
+        [](emp::Ptr<TraitInfo> a, emp::Ptr<TraitInfo> b){ return a->GetName() < b->GetName(); });
+      return traits;
+    }
+
     bool GetLocked() const { return locked; }
     void Lock() { locked = true; }
     void Unlock() { locked = false; }
 
+    /// Request compact storage for a trait; return false if no such trait exists.
+    bool SetCompact(const std::string & trait_name) {
+      auto trait_ptr = GetTraitInfo(trait_name);
+      if (!trait_ptr) return false;
+      trait_ptr->SetCompact();
+      return true;
+    }
+
+    /// Can a trait be stored compactly?  Only if every module using it does so through typed
+    /// trait objects; by-name access would expect the declared type in the DataMap.
+    bool CanStoreCompact(emp::Ptr<TraitInfo> trait_ptr) {
+      for (emp::Ptr<MOD_T> mod_ptr : trait_ptr->GetModules()) {
+        if (mod_ptr->HasTypedTraitAccess(trait_ptr->GetName())) continue;
+        emp::notify::Error("Trait '", trait_ptr->GetName(), "' cannot be stored compactly: module '",
+                           mod_ptr->GetName(), "' accesses it by name rather than through an ",
+                           "OrgTrait or TraitHandle.");
+        error_count++;
+        return false;
+      }
+      return true;
+    }
+
+    /// Convert traits marked as compact to their compact storage.  Bools are assigned bits in
+    /// shared words (in name order, for consistency between runs) and doubles become floats.
+    void SetupCompactStorage() {
+      const emp::TypeID bool_type = emp::GetTypeID<bool>();
+      const emp::TypeID double_type = emp::GetTypeID<double>();
+      size_t num_bits = 0;
+      emp::vector<uint8_t> word_defaults;
+
+      for (emp::Ptr<TraitInfo> trait_ptr : GetTraits()) {
+        if (!trait_ptr->IsCompact() || trait_ptr->GetStorage() != TraitInfo::Storage::NATIVE) {
+          continue;
+        }
+        const std::string & name = trait_ptr->GetName();
+        const bool is_bit = trait_ptr->GetType() == bool_type && trait_ptr->GetValueCount() == 1;
+        const bool is_double = trait_ptr->GetType() == double_type;
+        if ((is_bit || is_double) && !CanStoreCompact(trait_ptr)) continue;
+        if (is_bit) {
+          const size_t word_id = num_bits / 8;
+          const uint8_t mask = (uint8_t) (1 << (num_bits % 8));
+          if (word_id == word_defaults.size()) word_defaults.push_back(0);
+          auto bool_ptr = trait_ptr.DynamicCast<TypedTraitInfo<bool>>();
+          if (bool_ptr->HasDefault() && bool_ptr->GetDefault()) word_defaults[word_id] |= mask;
+          trait_ptr->SetPackedBit(emp::to_string("_packed_bits_", word_id), mask);
+          ++num_bits;
+        }
+        else if (is_double) {
+          trait_ptr->SetFloat32();
+        }
+        else {
+          emp::notify::Warning("Trait '", name, "' cannot be stored compactly (only single bools ",
+                               "and doubles can be); using normal storage.");
+        }
+      }
+
+      // Add the shared words as traits of their own, so they are registered, reset, and saved.
+      for (size_t word_id = 0; word_id < word_defaults.size(); ++word_id) {
+        const std::string word_name = emp::to_string("_packed_bits_", word_id);
+        emp_assert(!emp::Has(trait_map, word_name));
+        auto word_ptr = emp::NewPtr<TypedTraitInfo<uint8_t>>(word_name, word_defaults[word_id], 1);
+        word_ptr->SetDesc("Bits for compact bool traits");
+        trait_map[word_name] = word_ptr;
+      }
+    }
+
+    /// Print how many bytes each organism uses for each trait (directly in its DataMap; traits
+    /// such as strings or vectors may also use memory elsewhere).
+    void PrintStorageReport(std::ostream & os=std::cout) const {
+      size_t total_bytes = 0;
+      size_t native_bytes = 0;
+      os << "Trait storage (bytes per organism):\n";
+      for (emp::Ptr<TraitInfo> trait_ptr : GetTraits()) {
+        const size_t bytes = trait_ptr->GetStorageSize();
+        size_t native = bytes;
+        std::string note = "";
+        switch (trait_ptr->GetStorage()) {
+        case TraitInfo::Storage::NATIVE: break;
+        case TraitInfo::Storage::PACKED_BIT:
+          native = sizeof(bool);
+          note = emp::to_string(" (bit in ", trait_ptr->GetPackedWord(), ")");
+          break;
+        case TraitInfo::Storage::FLOAT32:
+          native = sizeof(double) * trait_ptr->GetValueCount();
+          note = " (float32)";
+          break;
+        }
+        if (trait_ptr->GetName().rfind("_packed_bits_", 0) == 0) native = 0;
+        os << "  " << trait_ptr->GetName() << " : " << bytes << note << "\n";
+        total_bytes += bytes;
+        native_bytes += native;
+      }
+      os << "  TOTAL : " << total_bytes << " (" << native_bytes << " without compact storage)"
+         << std::endl;
+    }
+
     /// Register all of the traits in the the provided DataMap.
     void RegisterAll(emp::DataMap & data_map) {
+      SetupCompactStorage();
       for (auto [name,trait_ptr] : trait_map) {
         trait_ptr->Register(data_map);
       }
     }
 
+    /// Precompute how to reset all traits in DataMaps with the provided (locked) layout.
+    void BuildResetImage(const emp::DataMap & data_map) {
+      reset_map = data_map;
+      reset_image.resize(0);
+      reset_blocks.resize(0);
+      reset_nontrivial.resize(0);
+      reset_anchor = nullptr;
+
+      // Collect trivial traits (by address) and set up non-trivial traits (by ID).
+      emp::vector<std::tuple<std::byte *, size_t, emp::Ptr<TraitInfo>, size_t>> trivial;
+      for (auto [name,trait_ptr] : trait_map) {
+        if (!reset_map.HasName(name)) continue;
+        const size_t id = reset_map.GetID(name);
+        trait_ptr->ResetValues(reset_map, id);
+        if (const size_t size = trait_ptr->GetTrivialSize(); size > 0) {
+          trivial.emplace_back(trait_ptr->GetTrivialPtr(reset_map, id), size, trait_ptr, id);
+        }
+        else reset_nontrivial.emplace_back(trait_ptr, id);
+      }
+
+      // Merge trivial traits that are adjacent in memory into blocks.
+      if (trivial.size()) {
+        std::sort(trivial.begin(), trivial.end(),
+                  [](const auto & a, const auto & b){ return std::get<0>(a) < std::get<0>(b); });
+        std::byte * anchor_ptr = std::get<0>(trivial[0]);
+        reset_anchor = std::get<2>(trivial[0]);
+        reset_anchor_id = std::get<3>(trivial[0]);
+        for (auto [ptr, size, trait_ptr, id] : trivial) {
+          const size_t offset = (size_t) (ptr - anchor_ptr);
+          if (reset_blocks.size() &&
+              reset_blocks.back().offset + reset_blocks.back().size == offset) {
+            reset_blocks.back().size += size;
+          }
+          else reset_blocks.push_back(ResetBlock{offset, size, reset_image.size()});
+          reset_image.insert(reset_image.end(), ptr, ptr + size);
+        }
+      }
+
+      has_reset_image = true;
+    }
+
+    /// Set all traits in the provided DataMap to their default values.
     void ResetAll(emp::DataMap & data_map){
-      for (auto [name,trait_ptr] : trait_map) trait_ptr->ResetToDefault(data_map);
+      if (!has_reset_image) {
+        for (auto [name,trait_ptr] : trait_map) trait_ptr->ResetToDefault(data_map);
+        return;
+      }
+
+      emp_assert(data_map.SameLayout(reset_map), "DataMap layout changed after reset image built.");
+      if (reset_anchor) {
+        std::byte * base = reset_anchor->GetTrivialPtr(data_map, reset_anchor_id);
+        for (const ResetBlock & block : reset_blocks) {
+          std::memcpy(base + block.offset, reset_image.data() + block.image_pos, block.size);
+        }
+      }
+      for (auto [trait_ptr, id] : reset_nontrivial) trait_ptr->ResetValues(data_map, id);
     }
 
     /**
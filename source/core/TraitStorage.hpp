@@ -0,0 +1,159 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  TraitStorage.hpp
+ *  @brief Typed access to traits that may be stored compactly (see TraitInfo::Storage).
+ *
+ *  A TraitLocation records where a trait is kept in an organism's DataMap and how it is encoded.
+ *  For bool and double traits, Access() returns a small reference-like object (BoolTraitRef or
+ *  DoubleTraitRef) that reads and writes the value whether or not compact storage is in use;
+ *  all other types are returned as plain references.
+ */
+
+#ifndef MABE_TRAIT_STORAGE_H
+#define MABE_TRAIT_STORAGE_H
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/data/DataMap.hpp"
+
+#include "Organism.hpp"
+#include "TraitInfo.hpp"
+
+namespace mabe {
+
+  /// Reference to a bool trait, which may be a single bit in a shared word.
+  class BoolTraitRef {
+  private:
+    emp::Ptr<bool> bool_ptr = nullptr;
+    emp::Ptr<uint8_t> word_ptr = nullptr;
+    uint8_t mask = 0;
+
+  public:
+    BoolTraitRef(bool & in_bool) : bool_ptr(&in_bool) { }
+    BoolTraitRef(uint8_t & in_word, uint8_t in_mask) : word_ptr(&in_word), mask(in_mask) { }
+    BoolTraitRef(const BoolTraitRef &) = default;
+
+    operator bool() const { return bool_ptr ? *bool_ptr : (*word_ptr & mask); }
+
+    BoolTraitRef & operator=(bool in) {
+      if (bool_ptr) *bool_ptr = in;
+      else if (in) *word_ptr |= mask;
+      else *word_ptr &= (uint8_t) ~mask;
+      return *this;
+    }
+    BoolTraitRef & operator=(const BoolTraitRef & in) { return operator=((bool) in); }
+  };
+
+  /// Reference to a double trait, which may be stored as a float.
+  class DoubleTraitRef {
+  private:
+    emp::Ptr<double> double_ptr = nullptr;
+    emp::Ptr<float> float_ptr = nullptr;
+
+  public:
+    DoubleTraitRef(double & in) : double_ptr(&in) { }
+    DoubleTraitRef(float & in) : float_ptr(&in) { }
+    DoubleTraitRef(const DoubleTraitRef &) = default;
+
+    operator double() const { return double_ptr ? *double_ptr : (double) *float_ptr; }
+
+    DoubleTraitRef & operator=(double in) {
+      if (double_ptr) *double_ptr = in;
+      else *float_ptr = (float) in;
+      return *this;
+    }
+    DoubleTraitRef & operator=(const DoubleTraitRef & in) { return operator=((double) in); }
+
+    DoubleTraitRef & operator+=(double in) { return operator=((double) *this + in); }
+    DoubleTraitRef & operator-=(double in) { return operator=((double) *this - in); }
+    DoubleTraitRef & operator*=(double in) { return operator=((double) *this * in); }
+    DoubleTraitRef & operator/=(double in) { return operator=((double) *this / in); }
+  };
+
+  /// Which types are returned when accessing a single trait of type T?
+  template <typename T> struct TraitRefType {
+    using type = T &;
+    using const_type = const T &;
+  };
+  template <> struct TraitRefType<bool> {
+    using type = BoolTraitRef;
+    using const_type = bool;
+  };
+  template <> struct TraitRefType<double> {
+    using type = DoubleTraitRef;
+    using const_type = double;
+  };
+
+  /// Where (and how) a trait is stored in organisms' DataMaps.
+  struct TraitLocation {
+    using Storage = TraitInfo::Storage;
+
+    size_t id = emp::MAX_SIZE_T;        ///< DataMap ID of the trait (or its shared word).
+    Storage storage = Storage::NATIVE;  ///< Encoding used for this trait.
+    uint8_t mask = 0;                   ///< Bit used (PACKED_BIT only).
+
+    bool IsValid() const { return id != emp::MAX_SIZE_T; }
+
+    /// Find a trait in a locked DataMap; info_ptr (if provided) describes its storage.
+    /// Return false if the trait cannot be found.
+    bool Locate(const emp::DataMap & dm, const std::string & name,
+                emp::Ptr<const TraitInfo> info_ptr=nullptr) {
+      storage = info_ptr ? info_ptr->GetStorage() : Storage::NATIVE;
+      const bool packed = (storage == Storage::PACKED_BIT);
+      const std::string & dm_name = packed ? info_ptr->GetPackedWord() : name;
+      if (!dm.HasName(dm_name)) { id = emp::MAX_SIZE_T; return false; }
+      id = dm.GetID(dm_name);
+      mask = packed ? info_ptr->GetPackedMask() : 0;
+      return true;
+    }
+
+    /// Can a trait stored here be accessed as type T?
+    template <typename T>
+    bool IsCompatible(const emp::DataMap & dm) const {
+      switch (storage) {
+      case Storage::PACKED_BIT: return std::is_same<T,bool>() && dm.IsType<uint8_t>(id);
+      case Storage::FLOAT32:    return std::is_same<T,double>() && dm.IsType<float>(id);
+      default:                  return dm.IsType<T>(id);
+      }
+    }
+
+    /// Writable access; callers decide whether the organism must be marked as modified, so
+    /// this bypasses Organism's marking accessors.
+    template <typename T>
+    typename TraitRefType<T>::type Access(Organism & org) const {
+      emp_assert(IsValid(), "Trait accessed before its location was set.");
+      emp::AnnotatedType & traits = org;
+      if constexpr (std::is_same<T,bool>()) {
+        if (storage == Storage::PACKED_BIT) {
+          return BoolTraitRef(traits.GetTrait<uint8_t>(id), mask);
+        }
+      }
+      if constexpr (std::is_same<T,double>()) {
+        if (storage == Storage::FLOAT32) return DoubleTraitRef(traits.GetTrait<float>(id));
+      }
+      return traits.GetTrait<T>(id);
+    }
+
+    template <typename T>
+    typename TraitRefType<T>::const_type Access(const Organism & org) const {
+      emp_assert(IsValid(), "Trait accessed before its location was set.");
+      if constexpr (std::is_same<T,bool>()) {
+        if (storage == Storage::PACKED_BIT) return org.GetTrait<uint8_t>(id) & mask;
+      }
+      if constexpr (std::is_same<T,double>()) {
+        if (storage == Storage::FLOAT32) return org.GetTrait<float>(id);
+      }
+      return org.GetTrait<T>(id);
+    }
+  };
+
+}
+
+#endif
@@ -0,0 +1,427 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  TraitTracker.hpp
+ *  @brief Incrementally maintained summary statistics for selected traits.
+ *
+ *  A TraitTracker keeps a running count, sum, sum of squares, and min/max heaps for each tracked
+ *  trait in a population.  Every position is included (empty cells hold the empty organism's
+ *  values), so results match summaries of the whole population, as with Collection(pop).
+ *
+ *  Positions are marked dirty when an organism is placed or removed, when its traits are reset,
+ *  and whenever one of its traits is accessed for writing: non-const Organism::GetTrait() or
+ *  SetTrait() (by name or ID), and writable OrgTrait or TraitHandle access.  Reads through a const
+ *  organism (or OrgTrait/TraitHandle Read()) do not mark anything.  Update() then revisits only
+ *  the dirty positions, so the cost of keeping statistics current scales with how many organisms
+ *  changed rather than with population size.  (Writes made directly through an organism's
+ *  DataMap bypass this and must be followed by Organism::NoteTraitWrite().)
+ *
+ *  The tracker also maintains the population's TraitColumns (contiguous copies of numeric
+ *  traits), re-reading only dirty positions.
+ *
+ *  String traits (such as genomes) can also be tracked: each position keeps the content hash of
+ *  its value, and a HashCounts tallies how often each hash occurs.  Richness, entropy, and the
+ *  position of the mode are then available without copying or rehashing unchanged strings.
+ *
+ *  Sums are kept relative to a shift value (the first value seen) to limit cancellation, and are
+ *  recomputed exactly whenever most positions are dirty or many incremental updates have
+ *  accumulated.  Min/max heaps are repaired lazily: stale entries are discarded only when they
+ *  reach the top, and heaps are rebuilt when they grow too large.
+ *
+ *  MarkDirty() may be called from multiple threads at once; all other functions may not.
+ */
+
+#ifndef MABE_TRAIT_TRACKER_H
+#define MABE_TRAIT_TRACKER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/data/DataLayout.hpp"
+#include "emp/meta/TypeID.hpp"
+
+#include "HashCounts.hpp"
+#include "TraitColumns.hpp"
+
+namespace mabe {
+
+  class TraitTracker {
+  public:
+    /// Statistics that can be provided for a tracked trait.
+    enum class Stat { COUNT, SUM, MEAN, VARIANCE, STDDEV, MIN, MAX, RICHNESS, ENTROPY, NONE };
+
+    static constexpr size_t NO_POS = HashCounts::NO_POS;
+
+    /// Convert a DataCollect summary name to a Stat (NONE if it cannot be tracked).
+    static Stat ToStat(const std::string & summary_type) {
+      if (summary_type == "sum" || summary_type == "total") return Stat::SUM;
+      if (summary_type == "ave" || summary_type == "mean") return Stat::MEAN;
+      if (summary_type == "variance") return Stat::VARIANCE;
+      if (summary_type == "stddev") return Stat::STDDEV;
+      if (summary_type == "min") return Stat::MIN;
+      if (summary_type == "max") return Stat::MAX;
+      if (summary_type == "count") return Stat::COUNT;
+      if (summary_type == "unique" || summary_type == "richness") return Stat::RICHNESS;
+      if (summary_type == "entropy") return Stat::ENTROPY;
+      return Stat::NONE;
+    }
+
+  private:
+    using Kind = TraitColumns::Kind;
+    using entry_t = std::pair<double, size_t>;   ///< A value and the position it came from.
+
+    static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    struct Tracked {
+      std::string name;
+      size_t trait_id = 0;
+      Kind kind = Kind::UNKNOWN;
+      emp::vector<double> values;    ///< Last value recorded at each position (NaN if none).
+      size_t count = 0;              ///< Number of occupied positions.
+      double shift = NaN;            ///< Offset subtracted from all values before summing.
+      double sum = 0.0;              ///< Sum of (value - shift)
+      double sum_sq = 0.0;           ///< Sum of (value - shift)^2
+      emp::vector<entry_t> min_heap; ///< May contain stale entries.
+      emp::vector<entry_t> max_heap; ///< May contain stale entries.
+
+      void Add(double value) {
+        if (std::isnan(shift)) shift = value;
+        const double offset = value - shift;
+        sum += offset;
+        sum_sq += offset * offset;
+        count++;
+      }
+      void Remove(double value) {
+        const double offset = value - shift;
+        sum -= offset;
+        sum_sq -= offset * offset;
+        count--;
+      }
+
+      // Heap entries are valid only if they still match the value at their position.
+      bool IsCurrent(const entry_t & entry) const { return values[entry.second] == entry.first; }
+
+      template <typename COMPARE_T>
+      void Push(emp::vector<entry_t> & heap, entry_t entry, COMPARE_T compare) {
+        heap.push_back(entry);
+        std::push_heap(heap.begin(), heap.end(), compare);
+      }
+
+      template <typename COMPARE_T>
+      double Top(emp::vector<entry_t> & heap, COMPARE_T compare) {
+        while (heap.size() && !IsCurrent(heap.front())) {
+          std::pop_heap(heap.begin(), heap.end(), compare);
+          heap.pop_back();
+        }
+        emp_assert(heap.size() || count == 0);
+        return heap.size() ? heap.front().first : NaN;
+      }
+
+      void RebuildHeaps() {
+        min_heap.resize(0);
+        for (size_t pos = 0; pos < values.size(); ++pos) {
+          if (!std::isnan(values[pos])) min_heap.emplace_back(values[pos], pos);
+        }
+        max_heap = min_heap;
+        std::make_heap(min_heap.begin(), min_heap.end(), std::greater<entry_t>());
+        std::make_heap(max_heap.begin(), max_heap.end(), std::less<entry_t>());
+      }
+    };
+
+    /// A string trait, tracked by content hash.
+    struct Hashed {
+      std::string name;
+      size_t trait_id = 0;
+      emp::vector<uint64_t> hashes;  ///< Hash of the value at each position (0 if none).
+      HashCounts counts;             ///< How often each hash occurs.
+    };
+
+    emp::vector<Tracked> traits;
+    emp::vector<Hashed> hashed_traits;
+    TraitColumns columns;              ///< Mirrored traits, kept current by position.
+    emp::vector<size_t> dirty_pos;     ///< Positions changed since the last Update().
+    emp::vector<uint8_t> dirty_flag;   ///< For each position, is it already in dirty_pos?
+    std::mutex dirty_mutex;            ///< Protects dirty_pos when marking from threads.
+    bool rebuild = true;               ///< Should all statistics be recomputed from scratch?
+    size_t num_changes = 0;            ///< Incremental changes since the last full rebuild.
+
+    Tracked & GetTracked(size_t trait_id) {
+      for (Tracked & trait : traits) if (trait.trait_id == trait_id) return trait;
+      emp_assert(false, "Requested trait is not tracked.", trait_id);
+      return traits[0];
+    }
+
+    Hashed & GetHashed(size_t trait_id) {
+      for (Hashed & trait : hashed_traits) if (trait.trait_id == trait_id) return trait;
+      emp_assert(false, "Requested trait is not tracked by hash.", trait_id);
+      return hashed_traits[0];
+    }
+
+    /// Read through a const reference, so that reading never marks the position dirty.
+    template <typename ORG_T>
+    static uint64_t ReadHash(const ORG_T & org, size_t trait_id) {
+      return org.GetContentHash(trait_id);
+    }
+
+    template <typename ORGS_T>
+    void Rebuild(const ORGS_T & orgs) {
+      for (Tracked & trait : traits) {
+        trait.values.assign(orgs.size(), NaN);
+        trait.count = 0;
+        trait.shift = NaN;
+        trait.sum = trait.sum_sq = 0.0;
+        for (size_t pos = 0; pos < orgs.size(); ++pos) {
+          const double value = TraitColumns::ReadValue(*orgs[pos], trait.trait_id, trait.kind);
+          trait.values[pos] = value;
+          trait.Add(value);
+        }
+        trait.RebuildHeaps();
+      }
+      for (Hashed & trait : hashed_traits) {
+        trait.hashes.resize(orgs.size());
+        trait.counts.Clear();
+        for (size_t pos = 0; pos < orgs.size(); ++pos) {
+          trait.hashes[pos] = ReadHash(*orgs[pos], trait.trait_id);
+          if (trait.hashes[pos]) trait.counts.Add(trait.hashes[pos], pos);
+        }
+      }
+      columns.Rebuild(orgs);
+      num_changes = 0;
+    }
+
+  public:
+    TraitTracker() = default;
+    TraitTracker(const TraitTracker &) = delete;
+    TraitTracker & operator=(const TraitTracker &) = delete;
+
+    /// Is any trait being tracked or mirrored?  If not, marking positions is free.
+    bool IsActive() const {
+      return traits.size() || hashed_traits.size() || columns.GetNumColumns();
+    }
+
+    size_t GetNumTraits() const { return traits.size() + hashed_traits.size(); }
+
+    /// Is the trait with the given ID tracked?
+    bool HasTrait(size_t trait_id) const {
+      for (const Tracked & trait : traits) if (trait.trait_id == trait_id) return true;
+      return IsHashed(trait_id);
+    }
+
+    /// Is the trait with the given ID a string trait, tracked by hash?
+    bool IsHashed(size_t trait_id) const {
+      for (const Hashed & trait : hashed_traits) if (trait.trait_id == trait_id) return true;
+      return false;
+    }
+
+    /// Can the given statistic be provided for this trait?  Numeric traits provide COUNT
+    /// through MAX; string traits provide COUNT, RICHNESS, and ENTROPY.
+    bool HasStat(size_t trait_id, Stat stat) const {
+      if (stat == Stat::NONE || !HasTrait(trait_id)) return false;
+      const bool hash_stat = (stat == Stat::RICHNESS || stat == Stat::ENTROPY);
+      if (IsHashed(trait_id)) return hash_stat || stat == Stat::COUNT;
+      return !hash_stat;
+    }
+
+    /// Start tracking a trait; return false if it is not a single numeric value or string.
+    bool AddTrait(const emp::DataLayout & layout, const std::string & name) {
+      if (!layout.HasName(name)) return false;
+      const size_t trait_id = layout.GetID(name);
+      if (HasTrait(trait_id)) return true;
+      if (layout.GetType(trait_id) == emp::GetTypeID<std::string>() &&
+          layout.GetCount(trait_id) == 1) {
+        Hashed & trait = hashed_traits.emplace_back();
+        trait.name = name;
+        trait.trait_id = trait_id;
+        rebuild = true;
+        return true;
+      }
+      if (!TraitColumns::CanMirror(layout, trait_id)) return false;
+      Tracked & trait = traits.emplace_back();
+      trait.name = name;
+      trait.trait_id = trait_id;
+      trait.kind = TraitColumns::GetKind(layout.GetType(trait_id));
+      rebuild = true;
+      return true;
+    }
+
+    /// Is the trait with the given ID mirrored in a column?
+    bool HasColumn(size_t trait_id) const { return columns.HasColumn(trait_id); }
+
+    /// Start mirroring a numeric trait in a column; return false if it cannot be mirrored.
+    bool AddColumn(const emp::DataLayout & layout, const std::string & name) {
+      if (!columns.AddColumn(layout, name)) return false;
+      rebuild = true;
+      return true;
+    }
+
+    /// Get the value of a mirrored trait at each position (call Update() first).
+    std::span<const double> GetColumn(size_t trait_id) const {
+      return columns.GetValues(trait_id);
+    }
+
+    /// Get a view of a mirrored trait for use with DataCollect (call Update() first).
+    TraitColumns::View GetColumnView(size_t trait_id) const { return columns.GetView(trait_id); }
+
+    /// Note that the organism at a position (or one of its traits) may have changed.
+    void MarkDirty(size_t pos) {
+      if (!IsActive() || rebuild) return;
+      emp_assert(pos < dirty_flag.size(), pos, dirty_flag.size());
+      if (std::atomic_ref<uint8_t>(dirty_flag[pos]).exchange(1, std::memory_order_relaxed)) return;
+      std::lock_guard<std::mutex> lock(dirty_mutex);
+      dirty_pos.push_back(pos);
+    }
+
+    /// Note that everything may have changed (for example, the population was resized).
+    void MarkAll() { rebuild = true; }
+
+    /// Bring all statistics up to date.  ORGS_T must be indexable by position, giving pointers
+    /// to organisms.
+    template <typename ORGS_T>
+    void Update(const ORGS_T & orgs) {
+      if (!IsActive()) return;
+
+      // Do a full rebuild if requested, if most positions are dirty anyway, or if enough
+      // incremental changes have accumulated that rounding error may have built up.
+      num_changes += dirty_pos.size();
+      if (rebuild || dirty_pos.size() * 2 >= orgs.size() || num_changes > 16 * orgs.size() + 1024) {
+        Rebuild(orgs);
+      }
+      else {
+        for (Tracked & trait : traits) {
+          for (size_t pos : dirty_pos) {
+            const double old_value = trait.values[pos];
+            const double new_value =
+              TraitColumns::ReadValue(*orgs[pos], trait.trait_id, trait.kind);
+            if (old_value == new_value) continue;
+            if (!std::isnan(old_value)) trait.Remove(old_value);
+            trait.values[pos] = new_value;
+            if (std::isnan(new_value)) continue;
+            trait.Add(new_value);
+            trait.Push(trait.min_heap, entry_t{new_value, pos}, std::greater<entry_t>());
+            trait.Push(trait.max_heap, entry_t{new_value, pos}, std::less<entry_t>());
+          }
+          if (trait.min_heap.size() + trait.max_heap.size() > 4 * trait.count + 128) {
+            trait.RebuildHeaps();
+          }
+        }
+        for (Hashed & trait : hashed_traits) {
+          for (size_t pos : dirty_pos) {
+            const uint64_t old_hash = trait.hashes[pos];
+            const uint64_t new_hash = ReadHash(*orgs[pos], trait.trait_id);
+            if (old_hash == new_hash) continue;
+            if (old_hash) trait.counts.Remove(old_hash, pos);
+            if (new_hash) trait.counts.Add(new_hash, pos);
+            trait.hashes[pos] = new_hash;
+          }
+        }
+        columns.Update(orgs, dirty_pos);
+      }
+
+      for (size_t pos : dirty_pos) dirty_flag[pos] = 0;
+      dirty_pos.resize(0);
+      dirty_flag.resize(orgs.size(), 0);
+      rebuild = false;
+    }
+
+    size_t GetCount(size_t trait_id) {
+      if (IsHashed(trait_id)) return GetHashed(trait_id).counts.GetTotal();
+      return GetTracked(trait_id).count;
+    }
+
+    /// Number of distinct values of a string trait.
+    size_t GetRichness(size_t trait_id) { return GetHashed(trait_id).counts.GetRichness(); }
+
+    /// Entropy of the values of a string trait.
+    double GetEntropy(size_t trait_id) { return GetHashed(trait_id).counts.GetEntropy(); }
+
+    /// Position of an organism with the most common value of a string trait (ties go to the
+    /// smallest hash, as in BuildHashedCollectFun()); NO_POS if there are no organisms.
+    size_t GetModePos(size_t trait_id) {
+      Hashed & trait = GetHashed(trait_id);
+      const uint64_t mode_hash = trait.counts.GetModeHash();
+      if (mode_hash == 0) return NO_POS;
+      size_t pos = trait.counts.GetPos(mode_hash);
+      if (pos == NO_POS) {    // The recorded example was removed; find another.
+        pos = (size_t) (std::find(trait.hashes.begin(), trait.hashes.end(), mode_hash)
+                        - trait.hashes.begin());
+        emp_assert(pos < trait.hashes.size());
+        trait.counts.SetPos(mode_hash, pos);
+      }
+      return pos;
+    }
+
+    double GetSum(size_t trait_id) {
+      const Tracked & trait = GetTracked(trait_id);
+      return trait.count ? trait.sum + trait.shift * trait.count : 0.0;
+    }
+
+    double GetMean(size_t trait_id) {
+      const Tracked & trait = GetTracked(trait_id);
+      return trait.count ? trait.shift + trait.sum / trait.count : NaN;
+    }
+
+    /// Sample variance (dividing by N-1), as used by DataCollect::Variance().
+    double GetVariance(size_t trait_id) {
+      const Tracked & trait = GetTracked(trait_id);
+      const double N = (double) trait.count;
+      const double var = (trait.sum_sq - trait.sum * trait.sum / N) / (N - 1.0);
+      return std::max(var, 0.0);
+    }
+
+    double GetStandardDeviation(size_t trait_id) { return std::sqrt(GetVariance(trait_id)); }
+
+    double GetMin(size_t trait_id) {
+      Tracked & trait = GetTracked(trait_id);
+      if (trait.count == 0) return std::numeric_limits<double>::max();
+      return trait.Top(trait.min_heap, std::greater<entry_t>());
+    }
+
+    double GetMax(size_t trait_id) {
+      Tracked & trait = GetTracked(trait_id);
+      if (trait.count == 0) return std::numeric_limits<double>::lowest();
+      return trait.Top(trait.max_heap, std::less<entry_t>());
+    }
+
+    /// Get any statistic for a tracked trait (call Update() first).
+    double GetStat(size_t trait_id, Stat stat) {
+      switch (stat) {
+        case Stat::COUNT:    return (double) GetCount(trait_id);
+        case Stat::SUM:      return GetSum(trait_id);
+        case Stat::MEAN:     return GetMean(trait_id);
+        case Stat::VARIANCE: return GetVariance(trait_id);
+        case Stat::STDDEV:   return GetStandardDeviation(trait_id);
+        case Stat::MIN:      return GetMin(trait_id);
+        case Stat::MAX:      return GetMax(trait_id);
+        case Stat::RICHNESS: return (double) GetRichness(trait_id);
+        case Stat::ENTROPY:  return GetEntropy(trait_id);
+        case Stat::NONE:     break;
+      }
+      emp_assert(false, "Unknown statistic requested from TraitTracker.");
+      return NaN;
+    }
+
+    /// Stop tracking (and mirroring) all traits.
+    void Clear() {
+      traits.resize(0);
+      hashed_traits.resize(0);
+      columns.Clear();
+      dirty_pos.resize(0);
+      dirty_flag.resize(0);
+      rebuild = true;
+    }
+  };
+
+}
+
+#endif
@@ -23,26 +23,70 @@
  *    "max_id"
  *    "ave" || "mean"
  *    "median"
+ *    "p<NN>" (e.g., "p90" for the 90th percentile)
+ *    "quantile<q>" (e.g., "quantile0.99")
  *    "variance"
  *    "stddev"
  *    "sum" || "total"
  *    "entropy"
+ *
+ *  Median and quantiles are exact (found with nth_element on a reused scratch buffer).  Adding a
+ *  '~' ("median~", "p90~", or "quantile~0.99") instead estimates them with a QuantileSketch,
+ *  which uses constant memory regardless of container size (rank error about 1%).
+ *
+ *  BuildHashedCollectFun(action, hash_fun, ref_fun) handles "mode", "richness" and "entropy" for
+ *  string values by counting content hashes (see HashCounts.hpp), so only the winning value is
+ *  ever read as a string.
+ *
+ *  Numeric (double) reductions first gather values into a contiguous buffer (or use a
+ *  container's own contiguous values; see IdentityFun) and then use the reproducible kernels in
+ *  ReduceKernels.hpp.
  */
 
 #ifndef EMP_DATA_COLLECT_H
 #define EMP_DATA_COLLECT_H
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <span>
 #include <string>
+#include <type_traits>
 
+#include "emp/base/vector.hpp"
 #include "emp/tools/string_utils.hpp"
 #include "emp/datastructs/vector_utils.hpp"
 #include "Emplode/Symbol.hpp"
 
+#include "HashCounts.hpp"
+#include "QuantileSketch.hpp"
+#include "ReduceKernels.hpp"
+
 namespace mabe {
   namespace DataCollect {
     using Symbol_Var = emplode::Symbol_Var;
 
+    /// Use as get_fun for containers that already hold the values to collect; if the container
+    /// provides GetSpan(), numeric reductions will read its values directly.
+    struct IdentityFun {
+      double operator()(double val) const { return val; }
+    };
+
+    /// Collect the numeric values for all entries in a container into contiguous memory.
+    /// The result is only valid until the next call on the same thread.
+    template <typename CONTAIN_T, typename FUN_T>
+    std::span<const double> GatherValues(const CONTAIN_T & container, FUN_T get_fun) {
+      if constexpr (std::is_same_v<FUN_T, IdentityFun> && requires { container.GetSpan(); }) {
+        return container.GetSpan();
+      }
+      else {
+        thread_local emp::vector<double> buffer;
+        buffer.resize(0);
+        for (const auto & entry : container) buffer.push_back( (double) get_fun(entry) );
+        return std::span<const double>(buffer.data(), buffer.size());
+      }
+    }
+
     // Return the value at a specified index.
     template <typename CONTAIN_T, typename FUN_T>
     Symbol_Var Index(const CONTAIN_T & container, FUN_T get_fun, const size_t index) {
@@ -80,6 +124,9 @@ namespace mabe {
 
     template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
     Symbol_Var Min(const CONTAIN_T & container, FUN_T get_fun) {
+      if constexpr (std::is_same_v<DATA_T, double>) {
+        return Reduce::Min( GatherValues(container, get_fun) );
+      }
       DATA_T min{};
       if constexpr (std::is_arithmetic_v<DATA_T>) {
         min = std::numeric_limits<DATA_T>::max();
@@ -96,6 +143,9 @@ namespace mabe {
 
     template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
     Symbol_Var Max(const CONTAIN_T & container, FUN_T get_fun) {
+      if constexpr (std::is_same_v<DATA_T, double>) {
+        return Reduce::Max( GatherValues(container, get_fun) );
+      }
       DATA_T max{};
       if constexpr (std::is_arithmetic_v<DATA_T>) {
         max = std::numeric_limits<DATA_T>::lowest();
@@ -144,6 +194,10 @@ namespace mabe {
 
     template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
     Symbol_Var Mean(const CONTAIN_T & container, FUN_T get_fun) {
+      if constexpr (std::is_same_v<DATA_T, double>) {
+        std::span<const double> values = GatherValues(container, get_fun);
+        return Reduce::Sum(values) / (double) values.size();
+      }
       if constexpr (std::is_arithmetic_v<DATA_T>) {
         double total = 0.0;
         size_t count = 0;
@@ -156,19 +210,85 @@ namespace mabe {
       return std::string{"nan"};
     }
 
+    /// Position in sorted order of quantile q (0.0 to 1.0) among count values.
+    inline size_t QuantileIndex(size_t count, double q) {
+      emp_assert(count > 0);
+      const double pos = std::clamp(q, 0.0, 1.0) * (double) count;
+      return std::min(count - 1, (size_t) pos);
+    }
+
+    // Return the exact value at quantile q, without fully sorting.
     template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
-    Symbol_Var Median(const CONTAIN_T & container, FUN_T get_fun) {
-      emp::vector<DATA_T> values(container.size());
-      size_t count = 0;
-      for (const auto & entry : container) {
-        values[count++] = get_fun(entry);
+    Symbol_Var Quantile(const CONTAIN_T & container, FUN_T get_fun, double q) {
+      if (container.size() == 0) return std::string{"nan"};
+      if constexpr (std::is_same_v<DATA_T, double>) {
+        std::span<const double> values = GatherValues(container, get_fun);
+        thread_local emp::vector<double> scratch;
+        scratch.assign(values.begin(), values.end());
+        auto nth = scratch.begin() + QuantileIndex(scratch.size(), q);
+        std::nth_element(scratch.begin(), nth, scratch.end());
+        return *nth;
+      }
+      else {
+        emp::vector<DATA_T> values;
+        values.reserve(container.size());
+        for (const auto & entry : container) values.push_back( get_fun(entry) );
+        auto nth = values.begin() + QuantileIndex(values.size(), q);
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
+      }
+    }
+
+    // Estimate the value at quantile q in constant memory; non-numeric values are exact.
+    template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
+    Symbol_Var ApproxQuantile(const CONTAIN_T & container, FUN_T get_fun, double q) {
+      if constexpr (std::is_arithmetic_v<DATA_T>) {
+        thread_local QuantileSketch sketch;
+        sketch.Clear();
+        for (const auto & entry : container) sketch.Insert( (double) get_fun(entry) );
+        if (sketch.GetCount() == 0) return std::string{"nan"};
+        return sketch.GetQuantile(q);
       }
-      emp::Sort(values);
-      return values[count/2];
+      else return Quantile<DATA_T, CONTAIN_T>(container, get_fun, q);
+    }
+
+    template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
+    Symbol_Var Median(const CONTAIN_T & container, FUN_T get_fun) {
+      return Quantile<DATA_T, CONTAIN_T>(container, get_fun, 0.5);
+    }
+
+    /// Identify quantile actions: "median~", "p<NN>", or "quantile<q>", each optionally marked
+    /// approximate with a '~' ("p<NN>~" or "quantile~<q>").  Set q (0.0 to 1.0) and approx.
+    inline bool ParseQuantile(std::string action, double & q, bool & approx) {
+      approx = false;
+      if (action.size() && action.back() == '~') { approx = true; action.pop_back(); }
+      else if (action.starts_with("quantile~")) { approx = true; action.erase(8, 1); }
+
+      if (action == "median") { q = 0.5; return true; }
+
+      std::string value;
+      double scale = 1.0;
+      if (action.starts_with("quantile")) value = action.substr(8);
+      else if (action.starts_with("p")) { value = action.substr(1); scale = 100.0; }
+      else return false;
+
+      // Value must be a plain decimal number.
+      if (value.empty() || value == ".") return false;
+      if (std::count(value.begin(), value.end(), '.') > 1) return false;
+      for (char c : value) if (c != '.' && !emp::is_digit(c)) return false;
+
+      q = emp::from_string<double>(value) / scale;
+      return q <= 1.0;
     }
 
     template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
     Symbol_Var Variance(const CONTAIN_T & container, FUN_T get_fun) {
+      if constexpr (std::is_same_v<DATA_T, double>) {
+        std::span<const double> values = GatherValues(container, get_fun);
+        const double N = (double) values.size();
+        const double mean = Reduce::Sum(values) / N;
+        return Reduce::SumSquaredDev(values, mean) / (N-1);
+      }
       if constexpr (std::is_arithmetic_v<DATA_T>) {
         double total = 0.0;
         const double N = (double) container.size();
@@ -189,6 +309,12 @@ namespace mabe {
 
     template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
     Symbol_Var StandardDeviation(const CONTAIN_T & container, FUN_T get_fun) {
+      if constexpr (std::is_same_v<DATA_T, double>) {
+        std::span<const double> values = GatherValues(container, get_fun);
+        const double N = (double) values.size();
+        const double mean = Reduce::Sum(values) / N;
+        return sqrt(Reduce::SumSquaredDev(values, mean) / (N-1));
+      }
       if constexpr (std::is_arithmetic_v<DATA_T>) {
         double total = 0.0;
         const double N = (double) container.size();
@@ -209,6 +335,9 @@ namespace mabe {
 
     template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
     Symbol_Var Sum(const CONTAIN_T & container, FUN_T get_fun) {
+      if constexpr (std::is_same_v<DATA_T, double>) {
+        return Reduce::Sum( GatherValues(container, get_fun) );
+      }
       if constexpr (std::is_arithmetic_v<DATA_T>) {
         double total = 0.0;
         for (const auto & entry : container) {
@@ -221,6 +350,10 @@ namespace mabe {
 
     template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
     Symbol_Var Entropy(const CONTAIN_T & container, FUN_T get_fun) {
+      if constexpr (std::is_same_v<DATA_T, double>) {
+        double entropy = 0.0;
+        if (Reduce::Entropy(GatherValues(container, get_fun), entropy)) return entropy;
+      }
       std::map<DATA_T, size_t> vals;
       for (const auto & entry : container) {
         vals[ get_fun(entry) ]++;
@@ -233,6 +366,19 @@ namespace mabe {
       }
       return entropy;
     }
+
+    /// Count the content hashes of values; hash_fun must return a (non-zero) uint64_t that is
+    /// equal for equal values.  The result is only valid until the next call on the same thread.
+    template <typename CONTAIN_T, typename FUN_T>
+    const HashCounts & CountHashes(const CONTAIN_T & container, FUN_T hash_fun) {
+      thread_local HashCounts counts;
+      counts.Clear();
+      size_t pos = 0;
+      for (const auto & entry : container) {
+        counts.Add(hash_fun(entry), pos++);
+      }
+      return counts;
+    }
   } // End namespace DataCollect
 
   template <typename DATA_T, typename CONTAIN_T, typename FUN_T>
@@ -334,6 +480,51 @@ namespace mabe {
       };
     }
 
+    // Return a quantile, either exact or estimated with a QuantileSketch.
+    double quantile = 0.0;
+    bool approx = false;
+    if (DataCollect::ParseQuantile(action, quantile, approx)) {
+      if (approx) {
+        return [get_fun,quantile](const CONTAIN_T & container) {
+          return DataCollect::ApproxQuantile<DATA_T, CONTAIN_T>(container, get_fun, quantile);
+        };
+      }
+      return [get_fun,quantile](const CONTAIN_T & container) {
+        return DataCollect::Quantile<DATA_T, CONTAIN_T>(container, get_fun, quantile);
+      };
+    }
+
+    return std::function<emplode::Symbol_Var(const CONTAIN_T &)>();
+  }
+
+  /// Build "mode", "richness" (or "unique"), or "entropy" for string values by counting content
+  /// hashes; hash_fun gives each value's hash (see CountHashes) and ref_fun returns the value
+  /// itself, which is only read for the mode.  Ties for the mode go to the value with the
+  /// smallest hash.  Returns an empty function for any other action.
+  template <typename CONTAIN_T, typename HASH_FUN_T, typename FUN_T>
+  std::function<emplode::Symbol_Var(const CONTAIN_T &)>
+  BuildHashedCollectFun(const std::string & action, HASH_FUN_T hash_fun, FUN_T ref_fun) {
+    if (action == "unique" || action == "richness") {
+      return [hash_fun](const CONTAIN_T & container) {
+        return emplode::Symbol_Var( DataCollect::CountHashes(container, hash_fun).GetRichness() );
+      };
+    }
+
+    else if (action == "mode" || action == "dom" || action == "dominant") {
+      return [hash_fun, ref_fun](const CONTAIN_T & container) {
+        const HashCounts & counts = DataCollect::CountHashes(container, hash_fun);
+        const uint64_t mode_hash = counts.GetModeHash();
+        if (mode_hash == 0) return emplode::Symbol_Var( std::string{} );
+        return emplode::Symbol_Var( ref_fun(container.At(counts.GetPos(mode_hash))) );
+      };
+    }
+
+    else if (action == "entropy") {
+      return [hash_fun](const CONTAIN_T & container) {
+        return emplode::Symbol_Var( DataCollect::CountHashes(container, hash_fun).GetEntropy() );
+      };
+    }
+
     return std::function<emplode::Symbol_Var(const CONTAIN_T &)>();
   }
 
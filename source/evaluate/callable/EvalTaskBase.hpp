@@ -42,6 +42,28 @@ namespace mabe {
     double reward_value = 1;          ///< Magnitude of the reward bestowed for completion of the task 
     RewardType reward_type = ADD; /// How do we apply the reward to the organism's merit?
 
+    // Direct access to the traits above (resolved once the DataMap is ready).
+    TraitHandle<emp::vector<data_t>> inputs_handle{this, inputs_trait};
+    TraitHandle<emp::vector<data_t>> outputs_handle{this, outputs_trait};
+    TraitHandle<double> fitness_handle{this, fitness_trait};
+    TraitHandle<bool> performed_handle{this, performed_trait};
+
+    /// Apply this task's reward to an organism's fitness.
+    void ApplyReward(Organism & hw) {
+      auto fitness = fitness_handle(hw);
+      switch(reward_type){
+        case ADD:
+          fitness += reward_value;
+          break;
+        case MULT:
+          fitness *= reward_value;
+          break;
+        case POW: // new = old * (2 ^ power)
+          fitness *= std::pow(2.0, reward_value);
+          break;
+      }
+    }
+
   public:
     EvalTaskBase(mabe::MABE & _control,
                   const std::string & _mod_name="EvalTaskBase",
@@ -91,69 +113,43 @@ namespace mabe {
 
     /// Evaluate an organism on the given logic task (assuming only one argument is needed)
     bool EvaluateOneArg(Organism& hw){
-      bool& task_performed = hw.GetTrait<bool>(performed_trait);
-      if(!task_performed){ // Only do check if org hasn't already performed the task
-        emp::vector<data_t>& input_vec = hw.GetTrait<emp::vector<data_t>>(inputs_trait);
-        emp::vector<data_t>& output_vec = hw.GetTrait<emp::vector<data_t>>(outputs_trait);
-        double original_fitness = hw.GetTrait<double>(fitness_trait);
+      if(!performed_handle.Read(hw)){ // Only do check if org hasn't already performed the task
+        const emp::vector<data_t>& input_vec = inputs_handle.Read(hw);
+        const emp::vector<data_t>& output_vec = outputs_handle.Read(hw);
         if(input_vec.size() > 0 && output_vec.size() > 0){
-          data_t& output = *output_vec.rbegin(); // Check latest output
+          const data_t& output = *output_vec.rbegin(); // Check latest output
           for(data_t input : input_vec){ // Must check against all inputs
             if( CheckOneArg(output, input) ){ // Unary check
-              switch(reward_type){
-                case ADD:
-                  hw.SetTrait<double>(fitness_trait, original_fitness + reward_value);
-                  break;
-                case MULT:
-                  hw.SetTrait<double>(fitness_trait, original_fitness * reward_value);
-                  break;
-                case POW: // new = old * (2 ^ power)
-                  hw.SetTrait<double>(fitness_trait, 
-                      original_fitness * std::pow(2.0, reward_value));
-                  break;
-              }
-              task_performed = true;
+              ApplyReward(hw);
+              performed_handle(hw) = true;
               return true;
             }
           }
         }
       }
-      return task_performed;
+      return performed_handle.Read(hw);
     } 
 
     /// Evaluate an organism on the given logic task (assuming two arguments are needed)
     bool EvaluateTwoArg(Organism& hw){
-      bool& task_performed = hw.GetTrait<bool>(performed_trait);
-      if(!task_performed){ // Only do check if org hasn't already performed the task
-        emp::vector<data_t>& input_vec = hw.GetTrait<emp::vector<data_t>>(inputs_trait);
-        emp::vector<data_t>& output_vec = hw.GetTrait<emp::vector<data_t>>(outputs_trait);
-        double original_fitness = hw.GetTrait<double>(fitness_trait);
+      if(!performed_handle.Read(hw)){ // Only do check if org hasn't already performed the task
+        const emp::vector<data_t>& input_vec = inputs_handle.Read(hw);
+        const emp::vector<data_t>& output_vec = outputs_handle.Read(hw);
         if(input_vec.size() > 1 && output_vec.size() > 0){
-          data_t& output = *output_vec.rbegin(); // Fetch latest output
+          const data_t& output = *output_vec.rbegin(); // Fetch latest output
           // Must check all possible pairs of input values
           for(size_t idx_a = 0; idx_a < input_vec.size() - 1; idx_a++){
             for(size_t idx_b = idx_a + 1; idx_b < input_vec.size(); idx_b++){
               if( CheckTwoArg(output, input_vec[idx_a], input_vec[idx_b]) ){ // Binary check
-                switch(reward_type){
-                  case ADD:
-                    hw.SetTrait<double>(fitness_trait, original_fitness + reward_value);
-                    break;
-                  case MULT:
-                    hw.SetTrait<double>(fitness_trait, original_fitness * reward_value);
-                    break;
-                  case POW: // new = old * (2 ^ power)
-                    hw.SetTrait<double>(fitness_trait, 
-                        original_fitness * std::pow(2.0, reward_value));
-                    break;
-                }
-                task_performed = true;
+                ApplyReward(hw);
+                performed_handle(hw) = true;
                 return true;
               }
             }
           }
         }
       }
-      return task_performed;
+      return performed_handle.Read(hw);
     }
 
     /// Evaluate all organisms in the collection
@@ -189,6 +185,7 @@ namespace mabe {
     static void InitType(emplode::TypeInfo & info) {
       info.AddMemberFunction("EVAL",
           [](derived_t& mod, Collection list) { 
+            auto timer = mod.Profile("EVAL");
             return mod.EvaluateCollection(list); 
           },
           "Evaluate all orgs in OrgList on a logic task");
@@ -205,9 +202,7 @@ namespace mabe {
 
     /// When a new organism is placed, set "task performed" trait to false
     void OnPlacement(OrgPosition placement_pos) override{
-      Population & pop = placement_pos.Pop();
-      size_t org_idx = placement_pos.Pos();
-      pop[org_idx].SetTrait<bool>(performed_trait, false);
+      performed_handle(placement_pos.Pop()[placement_pos.Pos()]) = false;
     }
   };
 
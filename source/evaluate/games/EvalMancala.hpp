@@ -49,7 +49,10 @@ namespace mabe {
     // Setup member functions associated with this class.
     static void InitType(emplode::TypeInfo & info) {
       info.AddMemberFunction("EVAL",
-                             [](EvalMancala & mod, Collection orgs) { return mod.Evaluate(orgs); },
+                             [](EvalMancala & mod, Collection orgs) {
+                               auto timer = mod.Profile("EVAL");
+                               return mod.Evaluate(orgs);
+                             },
                              "Evaluate organism's ability to play the game Mancala.");
       info.AddMemberFunction("TRACE",
                              [](EvalMancala & mod, Collection orgs, const std::string & filename) {
@@ -232,26 +235,30 @@ namespace mabe {
 
       control.Verbose(" - ", alive_collect.GetSize(), " organisms found.");
 
-      size_t org_count = 0;
-      double max_fitness = 0.0;
-      for (Organism & org : alive_collect) {
-        control.Verbose("...eval org #", org_count++);
+      // Evaluate all of the organisms in parallel; each thread only writes to its own orgs and
+      // draws opponent moves from its own random stream.
+      ParallelEvaluate(alive_collect, [this](Organism & org, emp::Random & random) {
         double & scoreA = scoreA_trait(org);
         double & scoreB = scoreB_trait(org);
         double & num_errors = error_trait(org);
         double & fitness = fitness_trait(org);
-        Results results = EvalGame(org, control.GetRandom());  // Start first.
+        Results results = EvalGame(org, random);  // Start first.
         scoreA = results.scoreA;
         scoreB = results.scoreB;
         num_errors = results.num_errors;
         fitness = results.CalcFitness();
 
-        results = EvalGame(org, control.GetRandom(), 1);  // Start second.
+        results = EvalGame(org, random, 1);  // Start second.
         scoreA += results.scoreA;
         scoreB += results.scoreB;
         num_errors += results.num_errors;
         fitness += results.CalcFitness();
+      });
 
+      // Find the max fitness back on the main thread.
+      double max_fitness = 0.0;
+      for (const Organism & org : alive_collect) {
+        const double fitness = fitness_trait.Read(org);
         if (fitness > max_fitness) max_fitness = fitness;
       }
 
@@ -65,7 +65,10 @@ namespace mabe {
     // Setup member functions associated with this class.
     static void InitType(emplode::TypeInfo & info) {
       info.AddMemberFunction("EVAL",
-                             [](EvalFunction & mod, Collection orgs) { return mod.Evaluate(orgs); },
+                             [](EvalFunction & mod, Collection orgs) {
+                               auto timer = mod.Profile("EVAL");
+                               return mod.Evaluate(orgs);
+                             },
                              "Evaluate organism's ability to solve a target function.");
     }
 
@@ -138,11 +141,8 @@ namespace mabe {
 
       control.Verbose(" - ", alive_collect.GetSize(), " organisms found.");
 
-      size_t org_count = 0;
-      double max_fitness = 0.0;
-      for (Organism & org : alive_collect) {
-        control.Verbose("...eval org #", org_count++);
-
+      // Evaluate all of the organisms in parallel; each thread only writes to its own orgs.
+      ParallelEvaluate(alive_collect, [this](Organism & org, emp::Random &) {
         double & ouput = org.GetTrait<double>(output_id);
         double & errors = org.GetTrait<emp::vector<double>>(errors_id);
         double & fitness = org.GetTrait<double>(fitness_trait);
@@ -160,7 +160,12 @@ namespace mabe {
           // Evaluate the results.
 
         }
+      });
 
+      // Find the max fitness back on the main thread.
+      double max_fitness = 0.0;
+      for (const Organism & org : alive_collect) {
+        const double fitness = org.GetTrait<double>(fitness_id);
         if (fitness > max_fitness) max_fitness = fitness;
       }
 
@@ -37,7 +37,10 @@ namespace mabe {
     // Setup member functions associated with this class.
     static void InitType(emplode::TypeInfo & info) {
       info.AddMemberFunction("EVAL",
-                             [](EvalCountBits & mod, Collection list) { return mod.Evaluate(list); },
+                             [](EvalCountBits & mod, Collection list) {
+                               auto timer = mod.Profile("EVAL");
+                               return mod.Evaluate(list);
+                             },
                              "Count the ones in all orgs in an OrgList.");
     }
 
@@ -52,7 +52,10 @@ namespace mabe {
     static void InitType(emplode::TypeInfo & info) {
       info.AddMemberFunction(
         "EVAL",
-        [](EvalDiagnostic & mod, Collection orgs) { return mod.Evaluate(orgs); },
+        [](EvalDiagnostic & mod, Collection orgs) {
+          auto timer = mod.Profile("EVAL");
+          return mod.Evaluate(orgs);
+        },
         "Evaluate organisms using the specified diagnostic."
       );
     }
@@ -73,13 +76,14 @@ namespace mabe {
     }
 
     double Evaluate(Collection orgs) {
-      // Track the organism with the highest total score.
-      double max_total = 0.0;
-      emp::Ptr<Organism> max_org = nullptr;
+      // Errors cannot be reported from worker threads, so check the diagnostic up front.
+      if (diagnostic_id >= NUM_DIAGNOSTICS) {
+        emp_error("Unknown Diganostic.");
+        return 0.0;
+      }
 
-      // Loop through the living organisms in the target collection to evaluate each.
-      mabe::Collection alive_collect( orgs.GetAlive() );
-      for (Organism & org : alive_collect) {        
+      // Evaluate all of the organisms in parallel; each thread only writes to its own orgs.
+      ParallelEvaluate(orgs, [this](Organism & org, emp::Random &) {
         // Make sure this organism has its values ready for us to access.
         org.GenerateOutput();
 
@@ -163,9 +167,15 @@ namespace mabe {
 
           break;
         default:
-          emp_error("Unknown Diganostic.");
+          break;
         }
+      });
 
+      // Track the organism with the highest total score.
+      double max_total = 0.0;
+      emp::Ptr<const Organism> max_org = nullptr;
+      for (const Organism & org : orgs.GetAlive()) {
+        const double total_score = total_trait.Read(org);
         if (total_score > max_total || !max_org) {
           max_total = total_score;
           max_org = &org;
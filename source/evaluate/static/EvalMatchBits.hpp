@@ -49,6 +49,7 @@ namespace mabe {
     static void InitType(emplode::TypeInfo & info) {
       info.AddMemberFunction("EVAL",
                              [](EvalMatchBits & mod, Collection list1, Collection list2) {
+                               auto timer = mod.Profile("EVAL");
                                return mod.Evaluate(list1, list2);
                               },
                              "Evaluate Bit Matching by comparing orgs in the two OrgLists.");
@@ -10,6 +10,8 @@
 #ifndef MABE_EVAL_NK_H
 #define MABE_EVAL_NK_H
 
+#include <algorithm>
+
 #include "../../core/EvalModule.hpp"
 #include "../../tools/NK.hpp"
 
@@ -46,25 +48,24 @@ namespace mabe {
     }
 
     double EvaluateCollection(const Collection & orgs) override {
-      // Loop through the population and evaluate each organism.
-      double max_fitness = 0.0;
-      emp::Ptr<Organism> max_org = nullptr;
-      mabe::Collection alive_orgs( orgs.GetAlive() );
-      for (Organism & org : alive_orgs) {
+      // Evaluate all of the organisms in parallel; each thread only writes to its own orgs.
+      ParallelEvaluate(orgs, [this](Organism & org, emp::Random &) {
         org.GenerateOutput();
+        const auto & bits = bits_trait(org);
+        fitness_trait(org) = (bits.size() == N) ? landscape.GetFitness(bits) : 0.0;
+      });
+
+      // Report any problems and find the max fitness back on the main thread (since
+      // error reporting is not thread safe).
+      double max_fitness = 0.0;
+      for (Organism & org : orgs.GetAlive()) {
         const auto & bits = bits_trait(org);
         if (bits.size() != N) {
           emp::notify::Error("Org returns ", bits.size(), " bits, but ",
                              N, " bits needed for NK landscape.",
                              "\nOrg: ", org.ToString());
         }
-        const double fitness = landscape.GetFitness(bits);
-        fitness_trait(org) = fitness;
-
-        if (fitness > max_fitness || !max_org) {
-          max_fitness = fitness;
-          max_org = &org;
-        }
+        max_fitness = std::max<double>(max_fitness, fitness_trait.Read(org));
       }
 
       return max_fitness;
@@ -42,6 +42,8 @@ namespace mabe {
     std::string fitness_trait; ///< Name of the trait that stores the resulting fitness
     size_t package_size = 6;   ///< Number of ones expected in a package
     size_t padding_size = 3;   ///< Number of zeros expected on each side of a package
+    TraitHandle<emp::BitVector> bits_handle{this, bits_trait};
+    TraitHandle<double> fitness_handle{this, fitness_trait};
 
   public:
     EvalPacking(mabe::MABE & control,
@@ -140,19 +142,20 @@ namespace mabe {
   
     /// Evaluate all organisms in a collection, return the max fitness
     double Evaluate(Collection orgs) {
-      // Loop through the population and evaluate each organism.
-      double max_fitness = 0.0;
-      mabe::Collection alive_collect( orgs.GetAlive() );
-      for (Organism & org : alive_collect) {        
+      // Evaluate all of the organisms in parallel; each thread only writes to its own orgs.
+      ParallelEvaluate(orgs, [this](Organism & org, emp::Random &) {
         // Make sure this organism has its bit sequence ready for us to access.
         org.GenerateOutput();
         // Get the bits_traits of the orgnism.
-        const emp::BitVector & bits = org.GetTrait<emp::BitVector>(bits_trait);
-        // Evaluate the fitness of the orgnism
-        double fitness = EvaluateOrg(bits, padding_size, package_size); 
-        // Set the fitness_trait for the organism
-        org.SetTrait<double>(fitness_trait, fitness);
-        // Update the max_fitness if applicable
+        const emp::BitVector & bits = bits_handle.Read(org);
+        // Evaluate the fitness of the orgnism and set its fitness_trait.
+        fitness_handle(org) = EvaluateOrg(bits, padding_size, package_size);
+      });
+
+      // Find the max_fitness back on the main thread.
+      double max_fitness = 0.0;
+      for (const Organism & org : orgs.GetAlive()) {
+        const double fitness = fitness_handle.Read(org);
         if (fitness > max_fitness) {
           max_fitness = fitness;
         }
@@ -164,6 +167,7 @@ namespace mabe {
     static void InitType(emplode::TypeInfo & info) {
       info.AddMemberFunction("EVAL",
          [](EvalPacking & mod, Collection list) { 
+           auto timer = mod.Profile("EVAL");
            return mod.Evaluate(list); 
          },
         "Evaluate all orgs in an OrgList on the packing problem.");
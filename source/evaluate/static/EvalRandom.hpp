@@ -38,7 +38,10 @@ namespace mabe {
     /// Set up the EVAL method to be used in the config file
     static void InitType(emplode::TypeInfo & info) {
       info.AddMemberFunction("EVAL",
-          [](EvalRandom & mod, Collection list) { return mod.Evaluate(list); },
+          [](EvalRandom & mod, Collection list) {
+            auto timer = mod.Profile("EVAL");
+            return mod.Evaluate(list);
+          },
           "Use EvalRandom to evaluate all orgs in an OrgList.");
     }
 
@@ -43,7 +43,10 @@ namespace mabe {
     // Setup member functions associated with this class.
     static void InitType(emplode::TypeInfo & info) {
       info.AddMemberFunction("EVAL",
-                             [](EvalRoyalRoad & mod, Collection list) { return mod.Evaluate(list); },
+                             [](EvalRoyalRoad & mod, Collection list) {
+                               auto timer = mod.Profile("EVAL");
+                               return mod.Evaluate(list);
+                             },
                              "Evaluate RoyalRoad on all orgs in an OrgList.");
     }
 
@@ -80,11 +80,18 @@ namespace mabe {
       if (SharedData().init_random) Randomize(random);
     }
 
+    /// The bit count lives in the DataMap, so there is nothing else to checkpoint.
+    bool SaveState(std::ostream &) const override { return true; }
+    bool LoadState(std::istream &) override { return true; }
+
     /// Put the bits in the correct output position.
     void GenerateOutput() override {
       // Nothing to do here - output already stored in DataMap.
     }
 
+    /// Output only touches this organism's own traits.
+    bool IsOutputThreadSafe() const override { return true; }
+
     /// Setup this organism type to be able to load from config.
     void SetupConfig() override {
       GetManager().LinkVar(SharedData().num_bits, "num_bits",
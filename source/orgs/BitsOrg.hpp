@@ -14,6 +14,7 @@
 #include "../core/MABE.hpp"
 #include "../core/Organism.hpp"
 #include "../core/OrganismManager.hpp"
+#include "../core/Serialize.hpp"
 
 #include "emp/bits/BitVector.hpp"
 #include "emp/math/Distribution.hpp"
@@ -78,11 +79,20 @@ namespace mabe {
       if (SharedData().init_random) emp::RandomizeBitVector(bits, random, 0.5);
     }
 
+    /// Save bits for a checkpoint.
+    bool SaveState(std::ostream & os) const override { BinaryWrite(os, bits); return true; }
+
+    /// Restore bits from a checkpoint.
+    bool LoadState(std::istream & is) override { return BinaryRead(is, bits); }
+
     /// Put the bits in the correct output position.
     void GenerateOutput() override {
       SetTrait<emp::BitVector>(SharedData().output_name, bits);
     }
 
+    /// Output only touches this organism's own traits.
+    bool IsOutputThreadSafe() const override { return true; }
+
     /// Setup this organism type to be able to load from config.
     void SetupConfig() override {
       GetManager().LinkFuns<size_t>([this](){ return bits.size(); },
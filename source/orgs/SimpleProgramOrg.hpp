@@ -387,6 +387,9 @@ namespace mabe {
       SetVar<double>(SharedData().total_name, total);
     }
 
+    /// Output only touches this organism's own traits.
+    bool IsOutputThreadSafe() const override { return true; }
+
     /// Setup this organism type to be able to load from config.
     void SetupConfig() override {
       GetManager().LinkFuns<size_t>([this](){ return vals.size(); },
@@ -118,11 +118,18 @@ namespace mabe {
     }
 
 
+    /// Values are stored as traits and checkpointed with them.
+    bool SaveState(std::ostream &) const override { return true; }
+    bool LoadState(std::istream &) override { return true; }
+
     /// Put the values in the correct output positions.
     void GenerateOutput() override {
       /// Output is already stored in the DataMap.
     }
 
+    /// Output only touches this organism's own traits.
+    bool IsOutputThreadSafe() const override { return true; }
+
     /// Setup this organism type to be able to load from config.
     void SetupConfig() override {
       GetManager().LinkVar(SharedData().num_vals, "N", "Number of values in organism");
@@ -25,11 +25,14 @@
 #ifndef MABE_VIRTUAL_CPU_ORGANISM_H
 #define MABE_VIRTUAL_CPU_ORGANISM_H
 
+#include <algorithm>
 #include <filesystem>
+#include <memory>
 
 #include "../core/MABE.hpp"
 #include "../core/Organism.hpp"
 #include "../core/OrganismManager.hpp"
+#include "../core/Serialize.hpp"
 
 #include "emp/datastructs/vector_utils.hpp"
 #include "emp/hardware/VirtualCPU.hpp"
@@ -57,64 +60,219 @@ namespace mabe {
     using data_vec_t = emp::vector<data_t>;
     using inst_func_t = std::function<void(this_t&, const this_t::inst_t&)>;
 
+    /// \brief A copy-on-write genome, shared (read-only) by organisms until one writes to it.
+    ///
+    /// Used for the offspring genome trait and for genomes that clones and offspring share with
+    /// their parent until they first run or change (see BuildGenome).
+    ///
+    /// @note Buffers are not binary serializable, so checkpoints skip the offspring genome trait
+    /// (it is reset on restore, like the rest of the hardware state); genomes themselves are
+    /// saved through SaveState() whether or not they are shared.
+    class GenomeBuffer {
+    private:
+      std::shared_ptr<genome_t> genome_ptr = nullptr;
+    public:
+      GenomeBuffer() = default;
+      GenomeBuffer(const genome_t & in_genome)
+        : genome_ptr(std::make_shared<genome_t>(in_genome)) { }
+
+      /// Does this buffer hold a genome (possibly an empty one)?
+      bool IsSet() const { return (bool) genome_ptr; }
+      size_t GetSize() const { return genome_ptr ? genome_ptr->size() : 0; }
+      bool IsEmpty() const { return GetSize() == 0; }
+
+      /// How many organisms (or other holders) share this buffer?
+      size_t GetNumShares() const { return (size_t) genome_ptr.use_count(); }
+
+      const genome_t & Get() const {
+        emp_assert(genome_ptr, "Cannot Get() from a GenomeBuffer that was never written.");
+        return *genome_ptr;
+      }
+
+      /// Get a writable genome whose old contents will be replaced; only allocates if the
+      /// current buffer is shared (or missing).
+      genome_t & Overwrite() {
+        if (!genome_ptr || genome_ptr.use_count() > 1) {
+          genome_ptr = std::make_shared<genome_t>(GetInstLib());
+        }
+        return *genome_ptr;
+      }
+
+      /// Get a writable genome with the current contents (copied first if shared).
+      genome_t & Edit() {
+        if (!genome_ptr) genome_ptr = std::make_shared<genome_t>(GetInstLib());
+        else if (genome_ptr.use_count() > 1) genome_ptr = std::make_shared<genome_t>(*genome_ptr);
+        return *genome_ptr;
+      }
+
+      /// Stop sharing this buffer.
+      void Release() { genome_ptr = nullptr; }
+    };
+
+    /// \brief Where the mutations from one call to Mutate() land, each list in increasing order.
+    ///
+    /// Point sites are positions in the original genome; insertion and deletion sites are
+    /// positions in the genome after all insertions (but before any deletions).
+    struct MutationSites {
+      emp::vector<size_t> point_sites;
+      emp::vector<size_t> insert_sites;
+      emp::vector<size_t> delete_sites;
+
+      size_t GetCount() const {
+        return point_sites.size() + insert_sites.size() + delete_sites.size();
+      }
+    };
+
   protected: 
     size_t insts_speculatively_executed = 0;
     emp::BitVector non_speculative_inst_vec;
+    mutable bool genome_string_dirty = true; ///< Is the cached genome trait out of date?
+    uint64_t genome_hash = 0;        ///< Rolling hash of the genome (see CalcGenomeHash)
+
+    // Until an organism first runs or changes its genome, the genome only lives in a buffer
+    // shared with its parent or siblings and the hardware (genome and genome_working) is empty;
+    // reading the genome (including rendering it as text) does not build it.  Once built, any
+    // buffer left is an unchanged copy of the genome that clones can share; it is dropped at
+    // the first write, so code changing the genome must first call EditGenome() or
+    // ReplaceGenome().  (CloneOrganism() fills the buffer lazily; clones are made serially.)
+    mutable GenomeBuffer shared_genome;
+    bool genome_built = true;        ///< Does the hardware hold this organism's own genome?
+
+    /// Give this organism its own copy of its genome (if still shared) and build its hardware.
+    void BuildGenome(){
+      if(genome_built) return;
+      if(shared_genome.GetNumShares() == 1){  // No one else uses the buffer; take its genome.
+        genome = std::move(shared_genome.Edit());
+        shared_genome.Release();
+      }
+      else genome = shared_genome.Get();
+      genome_built = true;
+      ResetHardware();
+    }
+
+    /// Prepare for changes to the current genome: build it and stop sharing it.
+    void EditGenome(){
+      BuildGenome();
+      shared_genome.Release();
+    }
+
+    /// Prepare for the genome to be replaced as a whole (so there is no need to copy it).
+    void ReplaceGenome(){
+      if(!genome_built){
+        genome.resize(0);
+        genome_built = true;
+      }
+      shared_genome.Release();
+    }
+
+    // The genome hash is the sum of InstHash(inst) * HASH_BASE^pos over all positions (mod 2^64),
+    // so a point mutation updates it by adjusting a single term, and a genome rebuilt after
+    // insertions or deletions accumulates it in the same pass.
+    static constexpr uint64_t HASH_BASE = 0x9E3779B97F4A7C15ull;
+
+    static uint64_t InstHash(size_t inst_idx) {
+      uint64_t hash = (inst_idx + 1) * 0xBF58476D1CE4E5B9ull;
+      return hash ^ (hash >> 31);
+    }
+    static uint64_t HashBasePow(size_t exp) {
+      uint64_t result = 1, base = HASH_BASE;
+      for (; exp; exp >>= 1, base *= base) if (exp & 1) result *= base;
+      return result;
+    }
 
     /// Perform a single point mutation at the given position
     void Mutate_Point(size_t pos, emp::Random& random){
       size_t old_inst_idx = genome[pos].idx;
       RandomizeInst(pos, random);
       while(genome[pos].idx == old_inst_idx) RandomizeInst(pos, random);
+      genome_hash += (InstHash(genome[pos].idx) - InstHash(old_inst_idx)) * HashBasePow(pos);
+      genome_string_dirty = true;
     }
 
-    /// Perform a single insertion mutation at the given position
-    void Mutate_Insertion(size_t pos, emp::Random& random){
-      InsertRandomInst(pos, random);
+    /// Set the hash and length traits; the genome trait is only rendered when read (see
+    /// GetGenomeText), so births, clones, and mutations never build the string.
+    void SyncGenomeTraits(){
+      SharedData().genome_hash_trait(*this) = genome_hash;
+      SharedData().length_trait(*this) = GetGenomeSize();
     }
 
-    /// Perform a single deletion mutation at the given position
-    void Mutate_Deletion(size_t pos, emp::Random& /*random*/){
-      RemoveInst(pos);
+    /// Note that the genome was replaced as a whole.
+    void OnGenomeReplaced(){
+      genome_hash = CalcGenomeHash();
+      genome_string_dirty = true;
     }
 
-    /// Apply mutations according to the passed parameters, and then call the given function 
-    /// for each mutation
-    size_t Mutate_Generic(
-        std::function<void(size_t, emp::Random&)> mut_func,
-        emp::CombinedBinomialDistribution& dist, 
-        emp::Random& random, 
-        bool ensure_unique_pos = true){
-      const size_t num_muts = dist.PickRandom(GetGenomeSize(), random);
-
-      if(num_muts == 0){
-        return 0;
+    /// Choose count distinct sites in [0, range) uniformly at random (Floyd's algorithm, so one
+    /// draw per site), and store them in sites in increasing order.
+    static void ChooseSites(size_t range, size_t count, emp::Random & random,
+                            emp::vector<size_t> & sites){
+      sites.resize(0);
+      if(count >= range){
+        for(size_t pos = 0; pos < range; ++pos) sites.push_back(pos);
+        return;
       }
-      if(num_muts == 1){
-        const size_t pos = random.GetUInt(GetGenomeSize());
-        mut_func(pos, random);
-        return 1;
+      // Sites chosen so far; only their bits are ever set, and they are cleared before
+      // returning, so duplicate checks take constant time without clearing the whole range.
+      thread_local emp::BitVector chosen;
+      if(chosen.size() < range) chosen.resize(range);
+      for(size_t max_pos = range - count; max_pos < range; ++max_pos){
+        size_t pos = random.GetUInt(max_pos + 1);
+        if(chosen[pos]) pos = max_pos;
+        chosen[pos] = true;
+        sites.push_back(pos);
       }
-      // Only remaining option is num_muts > 1.
-      if(ensure_unique_pos){ // Ensure no two mutations hit the same site
-        emp::BitVector mut_sites(genome.size());
-        for (size_t i = 0; i < num_muts; i++) {
-          const size_t pos = random.GetUInt(GetGenomeSize());
-          if(mut_sites[pos]){ --i; continue; } // Duplicate position; try again.
-          mut_sites[pos] = true;
-          mut_func(pos, random);
-          if(mut_sites.size() != GetGenomeSize()){
-            mut_sites.resize(GetGenomeSize());
-          }
+      for(size_t pos : sites) chosen[pos] = false;
+      std::sort(sites.begin(), sites.end());
+    }
+
+    /// Build the mutated genome in one pass over the old one, using the chosen sites.  A shared
+    /// genome is read in place, so building the mutant is this organism's first (and only) copy.
+    void BuildMutatedGenome(const MutationSites & sites, emp::Random & random){
+      const emp::vector<size_t> & point_sites = sites.point_sites;
+      const emp::vector<size_t> & insert_sites = sites.insert_sites;
+      const emp::vector<size_t> & delete_sites = sites.delete_sites;
+      // Spare genome (per thread, since organisms may mutate in parallel); its memory is
+      // swapped in to hold the new genome.
+      thread_local genome_t genome_scratch(GetInstLib());
+      if(genome_built) std::swap(genome, genome_scratch);
+      const genome_t & old_genome = genome_built ? genome_scratch : shared_genome.Get();
+      const size_t mid_size = old_genome.size() + insert_sites.size();
+      genome.resize(mid_size - delete_sites.size(), GetDefaultInst());
+
+      size_t old_pos = 0, new_pos = 0, point_id = 0, insert_id = 0, delete_id = 0;
+      uint64_t hash = 0, factor = 1;
+      for(size_t mid_pos = 0; mid_pos < mid_size; ++mid_pos){
+        const bool is_insert =
+          insert_id < insert_sites.size() && insert_sites[insert_id] == mid_pos;
+        bool is_point = false;
+        if(is_insert) ++insert_id;
+        else{
+          is_point = point_id < point_sites.size() && point_sites[point_id] == old_pos;
+          if(is_point) ++point_id;
+          ++old_pos;
         }
-      }
-      else{ // Mutate without concern of mutations hitting the same site (e.g., deletion)
-        for (size_t i = 0; i < num_muts; i++) {
-          const size_t pos = random.GetUInt(GetGenomeSize());
-          mut_func(pos, random);
+        if(delete_id < delete_sites.size() && delete_sites[delete_id] == mid_pos){
+          ++delete_id;
+          continue;
         }
+
+        if(is_insert) RandomizeInst(new_pos, random);
+        else{
+          genome[new_pos] = old_genome[old_pos - 1];
+          if(is_point){
+            const size_t old_inst_idx = genome[new_pos].idx;
+            RandomizeInst(new_pos, random);
+            while(genome[new_pos].idx == old_inst_idx) RandomizeInst(new_pos, random);
+          }
+        }
+        hash += InstHash(genome[new_pos].idx) * factor;
+        factor *= HASH_BASE;
+        ++new_pos;
       }
-      return num_muts;
+      genome_hash = hash;
+      genome_string_dirty = true;
+      genome_built = true;
+      shared_genome.Release();
     }
 
   public:
@@ -135,7 +293,8 @@ namespace mabe {
       SharedTrait<double> merit_trait{this, "merit", "Value representing fitness of organism"};
       SharedTrait<double> offspring_merit_trait{this, "offspring_merit", "Fitness passed on to offspring"};
       OwnedTrait<std::string> genome_trait{this, "genome", "Organism's genome"};
-      SharedTrait<genome_t> offspring_genome_trait{this, "offspring_genome", "Latest genome copied"};
+      OwnedTrait<size_t> genome_hash_trait{this, "genome_hash", "Rolling hash of genome"};
+      SharedTrait<GenomeBuffer> offspring_genome_trait{this, "offspring_genome", "Latest genome copied"};
       OwnedTrait<genome_t> original_genome_trait{this, "original_genome", "Genome as passed from parent"};
       SharedTrait<OrgPosition> position_trait{this, "position", "Organism's position"};
       OwnedTrait<size_t> generation_trait{this, "generation", "Organism's generation"};
@@ -171,51 +330,131 @@ namespace mabe {
       emp::CombinedBinomialDistribution point_mut_dist; ///< Distribution of number of point mutations to occur.
       emp::CombinedBinomialDistribution insertion_mut_dist; ///< Distribution of number of insertion mutations to occur.
       emp::CombinedBinomialDistribution deletion_mut_dist; ///< Distribution of number of deletion mutations to occur.
-      emp::BitVector mut_sites; ///< A pre-allocated vector for mutation sites. 
     };
 
-    /// Mutate (in place) the current organism.
+    /// Choose the mutations for a genome of the given size, using the configured rates.
+    ///
+    /// The number of each kind of mutation is drawn from its binomial distribution, and the
+    /// sites from Floyd's algorithm: point mutations hit distinct sites; insertions land in
+    /// random places, as if made one at a time at a random position of the growing genome;
+    /// deletions then remove distinct sites (possibly just-inserted ones).
+    void ChooseMutations(size_t old_size, emp::Random & random, MutationSites & sites){
+      ManagerData & data = SharedData();
+      size_t num_points = 0, num_inserts = 0, num_deletes = 0;
+      if(old_size > 0){
+        num_points = std::min(data.point_mut_dist.PickRandom(old_size, random), old_size);
+        num_inserts = data.insertion_mut_dist.PickRandom(old_size, random);
+        num_deletes = std::min(data.deletion_mut_dist.PickRandom(old_size + num_inserts, random),
+                               old_size + num_inserts);
+      }
+      const size_t mid_size = old_size + num_inserts;
+      ChooseSites(old_size, num_points, random, sites.point_sites);
+      // One insertion at a random position in a growing genome is the same as choosing distinct
+      // positions in the final genome (never the last one, which was never moved).
+      ChooseSites(mid_size ? mid_size - 1 : 0, num_inserts, random, sites.insert_sites);
+      ChooseSites(mid_size, num_deletes, random, sites.delete_sites);
+    }
+
+    /// Mutate (in place) the current organism: all sites are chosen first (see
+    /// ChooseMutations), then point mutations alone are made in place, while insertions and
+    /// deletions rebuild the genome in a single pass.
     size_t Mutate(emp::Random & random) override {
-      size_t mut_count = 0;
-      mut_count += Mutate_Generic(
-        [this](size_t pos, emp::Random& random){ Mutate_Point(pos, random); },
-        SharedData().point_mut_dist, random, true
-      );
-      mut_count += Mutate_Generic(
-        [this](size_t pos, emp::Random& random){ Mutate_Insertion(pos, random); },
-        SharedData().insertion_mut_dist, random, false 
-      );
-      mut_count += Mutate_Generic(
-        [this](size_t pos, emp::Random& random){ Mutate_Deletion(pos, random); },
-        SharedData().deletion_mut_dist, random, false
-      );
-      // Update hardware and traits accordingly
-      ResetWorkingGenome();
-      SharedData().genome_trait(*this) = GetGenomeString();
-      SharedData().length_trait(*this) = GetGenomeSize();
-      return mut_count;
+      thread_local MutationSites sites;  // Reused across calls on each thread.
+      const bool was_built = genome_built;
+      ChooseMutations(GetGenomeSize(), random, sites);
+      if(sites.insert_sites.size() + sites.delete_sites.size() == 0){
+        if(sites.point_sites.size()) EditGenome();
+        for(size_t pos : sites.point_sites) Mutate_Point(pos, random);
+      }
+      else BuildMutatedGenome(sites, random);
+      // Update hardware (if any; an unchanged genome stays shared) and traits accordingly
+      if(!was_built && genome_built) ResetHardware();
+      else if(genome_built) ResetWorkingGenome();
+      SyncGenomeTraits();
+      return sites.GetCount();
+    }
+
+    /// The genome, whether or not this organism still shares it.
+    const genome_t & ReadGenome() const { return genome_built ? genome : shared_genome.Get(); }
+
+    /// Number of instructions in the genome, whether or not this organism still shares it.
+    size_t GetGenomeSize() const { return ReadGenome().size(); }
+
+    /// Render the genome in the same format as VirtualCPU::GetGenomeString() (its size, then
+    /// one character per instruction), reading a shared genome in place rather than building it.
+    std::string GetGenomeString() const {
+      const genome_t & cur_genome = ReadGenome();
+      std::string out = emp::to_string("[", cur_genome.size(), "]");
+      out.reserve(out.size() + cur_genome.size());
+      for(const auto & inst : cur_genome){
+        unsigned char c = 'a' + inst.id;
+        if(inst.id > 25) c = 'A' + inst.id - 26;
+        out += c;
+      }
+      return out;
+    }
+
+    /// The genome as a string, rendered on the first read after the genome changes and cached
+    /// in the genome trait until the next change.
+    const std::string & GetGenomeText() const {
+      const size_t trait_id = SharedData().genome_trait.GetID();
+      if (genome_string_dirty) {
+        // The trait only caches the rendering, so updating it leaves the organism logically
+        // unchanged (and must not mark its traits as modified).
+        VirtualCPUOrg & self = const_cast<VirtualCPUOrg &>(*this);
+        self.emp::AnnotatedType::GetTrait<std::string>(trait_id) = GetGenomeString();
+        genome_string_dirty = false;
+      }
+      return emp::AnnotatedType::GetTrait<std::string>(trait_id);
+    }
+
+    /// Render the genome trait if it is out of date.
+    void SyncTraits() const override { GetGenomeText(); }
+
+    /// Hash of the genome, kept up to date through mutations; equal genomes have equal hashes.
+    uint64_t GetGenomeHash() const { return genome_hash; }
+
+    /// Count genomes by the maintained genome hash, so the genome string is never rendered.
+    /// (Zero marks a missing value for content hashes, so it is remapped.)
+    uint64_t GetContentHash(size_t trait_id) const override {
+      if (trait_id == SharedData().genome_trait.GetID()) return genome_hash ? genome_hash : 1;
+      return Organism::GetContentHash(trait_id);
+    }
+
+    /// Calculate the genome hash from scratch.
+    uint64_t CalcGenomeHash() const {
+      uint64_t hash = 0, factor = 1;
+      const genome_t & cur_genome = ReadGenome();
+      for (size_t pos = 0; pos < cur_genome.size(); ++pos, factor *= HASH_BASE) {
+        hash += InstHash(cur_genome[pos].idx) * factor;
+      }
+      return hash;
     }
 
     /// Randomize (in place) the organism's genome. Does not add new instructions.
     void Randomize(emp::Random & random) override {
+      EditGenome();
       for (size_t pos = 0; pos < GetGenomeSize(); pos++) {
         RandomizeInst(pos, random);
       }
       ResetWorkingGenome();
-      SharedData().genome_trait(*this) = GetGenomeString();
-      SharedData().length_trait(*this) = GetGenomeSize();
+      OnGenomeReplaced();
+      SyncGenomeTraits();
     }
 
     /// Pad the organism's genome out to the specified length with random instructions.
     void FillRandom(size_t length, emp::Random & random){
+      EditGenome();
       for (size_t pos = GetGenomeSize(); pos < length; pos++) {
         PushRandomInst(random);
       }
       ResetWorkingGenome();
+      OnGenomeReplaced();
     }
 
-    /// Reset organism's hardware to the top of the original genome
+    /// Reset organism's hardware to the top of the original genome (once it has been built)
     void ResetHardware(){
+      if(!genome_built) return;
       ResetWorkingGenome();
       expanded_nop_args = SharedData().expanded_nop_args;
       base_t::Initialize();
@@ -228,12 +467,13 @@ namespace mabe {
       const double merit = SharedData().merit_trait(*this);
       const size_t gen = SharedData().generation_trait(*this);
       const OrgPosition pos = SharedData().position_trait(*this);
+      std::string genome_str = std::move(SharedData().genome_trait(*this)); // Keep the cache
       GetManager().GetControl().ResetTraits(*this);
       SharedData().merit_trait(*this) = merit;
       SharedData().generation_trait(*this) = gen;
       SharedData().position_trait(*this) = pos;
-      SharedData().genome_trait(*this) = GetGenomeString();
-      SharedData().length_trait(*this) = GetGenomeSize();
+      SharedData().genome_trait(*this) = std::move(genome_str);
+      SyncGenomeTraits();
       SharedData().offspring_merit_trait(*this) = SharedData().initial_merit; 
     }
 
@@ -253,7 +493,9 @@ namespace mabe {
           emp::notify::Error("Cannot initialize genome; no such file '", filename, "'.");
         }
         else {
+          ReplaceGenome();
           Load(filename);
+          OnGenomeReplaced();
           SharedData().init_length = GetGenomeSize();
         }
       }
@@ -271,17 +513,29 @@ namespace mabe {
       ResetTraits();
     }
     
-    /// Create an offspring organism using the configuration file's mutation rate.
+    /// Make an organism with a copy of this organism's traits whose genome is the shared
+    /// buffer provided (empty if the buffer was never set).  It starts from the manager's
+    /// prototype, so no genome is copied; its hardware is built when first needed.
+    emp::Ptr<VirtualCPUOrg> MakeSharedCopy(const GenomeBuffer & in_genome) const {
+      auto copy_ptr = manager.Make<VirtualCPUOrg>();
+      VirtualCPUOrg & copy = *copy_ptr;
+      copy.SetDataMap(GetDataMap());
+      // The copy does not keep a share of the offspring genome (the parent may reuse it).
+      SharedData().offspring_genome_trait(copy).Release();
+      copy.genome.resize(0);
+      copy.genome_working.resize(0);
+      copy.shared_genome = in_genome;
+      copy.genome_built = !in_genome.IsSet();
+      return copy_ptr;
+    }
+
+    /// Create an offspring organism using the configuration file's mutation rate.  Unless it
+    /// mutates, the offspring shares the genome its parent copied until it first runs.
     emp::Ptr<Organism> MakeOffspringOrganism(emp::Random & random) const override {
       // Create and mutate
-      auto offspring_ptr = OrgType::Clone().DynamicCast<VirtualCPUOrg>();
+      auto offspring_ptr = MakeSharedCopy(SharedData().offspring_genome_trait(*this));
       VirtualCPUOrg & offspring = *offspring_ptr;
-      const genome_t offspring_genome = SharedData().offspring_genome_trait(*this);
-      offspring.genome.resize(offspring_genome.size(), GetDefaultInst());
-      std::copy( offspring_genome.begin(),
-                 offspring_genome.end(),
-                 offspring.genome.begin() );
-      offspring.ResetWorkingGenome();
+      offspring.OnGenomeReplaced();
       offspring.Mutate(random);
       offspring.Reset();
       double bonus = 0;
@@ -296,37 +550,56 @@ namespace mabe {
       SharedData().merit_trait(offspring) = bonus + SharedData().offspring_merit_trait(*this);
       SharedData().offspring_merit_trait(offspring) = SharedData().initial_merit;
       SharedData().generation_trait(offspring) = SharedData().generation_trait(*this) + 1;
-      offspring.CurateNops();
-      SharedData().genome_trait(offspring) = offspring.GetGenomeString();
-      SharedData().length_trait(offspring) = offspring.GetGenomeSize();
+      offspring.SyncGenomeTraits();
       SharedData().output_trait(offspring).clear();
-      offspring.ResetHardware();
-      offspring.insts_speculatively_executed = 0;
 
       return offspring_ptr;
     }
     
-    /// Create an identical organism with no mutations and with the same merit
+    /// Create an identical organism with no mutations and with the same merit.  Clones share
+    /// this organism's genome (copied into a buffer at most once) until they first run.
     virtual emp::Ptr<Organism> CloneOrganism() const override {
-      auto offspring_ptr = OrgType::Clone().DynamicCast<VirtualCPUOrg>();
+      if (!shared_genome.IsSet()) shared_genome = GenomeBuffer(genome);
+      auto offspring_ptr = MakeSharedCopy(shared_genome);
       VirtualCPUOrg & offspring = *offspring_ptr;
+      offspring.genome_hash = genome_hash;
+      offspring.genome_string_dirty = genome_string_dirty;
 
-      offspring.ResetWorkingGenome();
-      offspring.ResetHardware();
       SharedData().merit_trait(offspring) = SharedData().merit_trait(*this); 
       SharedData().offspring_merit_trait(offspring) = SharedData().initial_merit; 
-      SharedData().genome_trait(offspring) = offspring.GetGenomeString();
-      SharedData().length_trait(offspring) = offspring.GetGenomeSize();
+      offspring.SyncGenomeTraits();
       SharedData().output_trait(offspring).clear();
-      offspring.expanded_nop_args = SharedData().expanded_nop_args;
-      offspring.insts_speculatively_executed = 0;
 
       return offspring_ptr;
     }
 
+    /// Save the genome (as instruction indices) for a checkpoint.  Hardware state is not saved.
+    bool SaveState(std::ostream & os) const override {
+      const genome_t & cur_genome = ReadGenome();
+      emp::vector<uint32_t> inst_ids(cur_genome.size());
+      for (size_t pos = 0; pos < cur_genome.size(); ++pos) {
+        inst_ids[pos] = (uint32_t) cur_genome[pos].idx;
+      }
+      BinaryWrite(os, inst_ids);
+      return true;
+    }
+
+    /// Restore a genome from a checkpoint; hardware restarts at the top of the genome.
+    bool LoadState(std::istream & is) override {
+      emp::vector<uint32_t> inst_ids;
+      if (!BinaryRead(is, inst_ids)) return false;
+      ReplaceGenome();
+      genome.resize(0);
+      for (uint32_t inst_idx : inst_ids) PushInst((size_t) inst_idx);
+      OnGenomeReplaced();
+      ResetHardware();
+      return true;
+    }
+
     /// Load inputs and run the organism for a number of steps specified in the configuration
     /// file. Any generated outputs will be stored in the organism's output trait.
     void GenerateOutput() override {
+      BuildGenome();
       ResetHardware();
 
       // Setup the input.
@@ -351,7 +624,11 @@ namespace mabe {
       GetManager().LinkVar(SharedData().deletion_mut_prob, "deletion_mut_prob",
                       "Per-site probability of a deletion mutation");
       GetManager().LinkFuns<size_t>([this](){ return GetGenomeSize(); },
-                       [this](const size_t & /*N*/){ ClearGenome(); /*PushDefaultInst(N);*/ },
+                       [this](const size_t & /*N*/){
+                         ReplaceGenome();
+                         ClearGenome();
+                         OnGenomeReplaced();
+                       },
                        "N", "Initial number of instructions in genome");
       GetManager().LinkVar(SharedData().init_random, "init_random",
                       "Should we randomize ancestor?  (0 = \"blank\" default)");
@@ -487,13 +764,11 @@ namespace mabe {
             action.data.Get<std::string>("description") : "No description provided");
         const size_t num_args = 
           (action.data.HasName("num_args") ?  action.data.Get<size_t>("num_args") : 0);
+        // Resolve the action's handlers once, rather than type-checking them every call
+        const inst_func_t inst_func = action.BuildDispatch<VirtualCPUOrg&, const inst_t&>();
         inst_lib.AddInst(
             action.name,                       // Instruction name
-            [&action](VirtualCPUOrg& org, const inst_t& inst){
-              for(size_t func_idx = 0; func_idx < action.function_vec.size(); ++func_idx){
-                action.function_vec[func_idx].Call<void, VirtualCPUOrg&, const inst_t&>(org, inst);
-              }
-            },                                 // Function that will be executed
+            inst_func,                         // Function that will be executed
             num_args,                          // Number of arguments
             desc,                              // Description 
             emp::ScopeType::NONE,              // No scope type, but must provide
@@ -539,6 +814,7 @@ namespace mabe {
 
     /// Process the next instruction, or use speculative execution if possible
     bool ProcessStep() override { 
+      BuildGenome();
       if(GetWorkingGenomeSize() == 0) return false;
       if(SharedData().use_speculative_execution){
         Process_Speculative();
@@ -553,6 +829,23 @@ namespace mabe {
       return true;
     }
 
+    /// Process a whole time slice in one tight loop (unless per-step handling is needed);
+    /// the slice ends early if the organism reproduces (see EndTimeSlice()).
+    size_t ProcessSteps(size_t num_steps) override {
+      if(SharedData().use_speculative_execution || SharedData().verbose){
+        return Organism::ProcessSteps(num_steps);
+      }
+      BuildGenome();
+      if(GetWorkingGenomeSize() == 0) return 0;
+      end_slice = false;
+      size_t step = 0;
+      while(step < num_steps && !end_slice){
+        Process(1);
+        ++step;
+      }
+      return step;
+    }
+
     /// Initialize the mutational distribution variables to match the genome size (either 
     /// current size or projected sizes)
     void SetupMutationDistribution() {
@@ -561,7 +854,6 @@ namespace mabe {
         SharedData().insertion_mut_dist.Setup(SharedData().insertion_mut_prob, 
             GetGenomeSize());
         SharedData().deletion_mut_dist.Setup(SharedData().deletion_mut_prob, GetGenomeSize());
-        SharedData().mut_sites.Resize(GetGenomeSize());
       }
       else { // Otherwise, use the genome size set in the configuration file
         SharedData().point_mut_dist.Setup(SharedData().point_mut_prob, 
@@ -570,7 +862,6 @@ namespace mabe {
             SharedData().init_length);
         SharedData().deletion_mut_dist.Setup(SharedData().deletion_mut_prob, 
             SharedData().init_length);
-        SharedData().mut_sites.Resize(SharedData().init_length);
       }
     }
 
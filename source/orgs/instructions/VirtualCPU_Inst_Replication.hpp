@@ -31,6 +31,8 @@ namespace mabe {
     std::string org_pos_trait = "org_pos"; ///< Name of the trait storing organism's position
     std::string offspring_genome_trait = "offspring_genome"; ///< Name of the trait storing the genome of the offspring organism 
     std::string reset_self_trait = "reset_self"; ///< Name of the trait storing if org needs reset 
+    TraitHandle<OrgPosition> org_pos_handle{this, org_pos_trait};
+    TraitHandle<org_t::GenomeBuffer> offspring_genome_handle{this, offspring_genome_trait};
     double req_frac_inst_executed = 0.5;  /**< Config option indicating the fraction of 
                                             an organism's genome that must have been executed 
                                             for org to reproduce **/
@@ -72,10 +74,9 @@ namespace mabe {
         if(hw.GetGenomeSize() == hw.GetWorkingGenomeSize()){
           return;
         }
-        OrgPosition& org_pos = hw.GetTrait<OrgPosition>(org_pos_trait);
+        OrgPosition org_pos = org_pos_handle.Read(hw);
         // Store the soon-to-be offspring's genome
-        org_t::genome_t& offspring_genome = hw.GetTrait<org_t::genome_t>(
-            offspring_genome_trait);
+        org_t::genome_t& offspring_genome = offspring_genome_handle(hw).Overwrite();
         offspring_genome.resize(hw.genome_working.size() - hw.read_head,
             hw.GetDefaultInst());
         std::copy(
@@ -84,6 +85,7 @@ namespace mabe {
             offspring_genome.begin());
         hw.genome_working.resize(hw.read_head, hw.GetDefaultInst());
         // Replicate
+        hw.EndTimeSlice();  // The offspring may replace this organism, so stop its time slice.
         control.Replicate(org_pos, *org_pos.PopPtr());
         // Reset the parent
         hw.Reset();
@@ -120,16 +122,16 @@ namespace mabe {
             && hw.num_insts_executed >= (size_t)req_count_inst_executed)
           || (req_count_inst_executed < 0 
             && hw.num_insts_executed >= req_frac_inst_executed * hw.genome.size())){
-        OrgPosition& org_pos = hw.GetTrait<OrgPosition>(org_pos_trait);
+        OrgPosition org_pos = org_pos_handle.Read(hw);
         // Store the soon-to-be offspring's genome
-        org_t::genome_t& offspring_genome = hw.GetTrait<org_t::genome_t>(
-            offspring_genome_trait);
+        org_t::genome_t& offspring_genome = offspring_genome_handle(hw).Overwrite();
         offspring_genome.resize(hw.genome.size(), hw.GetDefaultInst());
         std::copy(
             hw.genome.begin(),
             hw.genome.end(),
             offspring_genome.begin());
         // Replicate 
+        hw.EndTimeSlice();  // The offspring may replace this organism, so stop its time slice.
         control.Replicate(org_pos, *org_pos.PopPtr());
         // Reset the parent
         hw.Reset();
@@ -162,7 +164,7 @@ namespace mabe {
     /// When config is loaded, create traits and set up functions
     void SetupModule() override {
       AddRequiredTrait<OrgPosition>(org_pos_trait);
-      AddRequiredTrait<org_t::genome_t>(offspring_genome_trait);
+      AddRequiredTrait<org_t::GenomeBuffer>(offspring_genome_trait);
       AddRequiredTrait<bool>(reset_self_trait);
       SetupFuncs();
     }
@@ -20,6 +20,7 @@ namespace mabe {
   private:
     Collection target_collect;         ///< Collection of populations to manage
     std::string pos_trait = "org_pos"; ///< Name of trait storing organism's position
+    TraitHandle<OrgPosition> pos_handle{this, pos_trait};
 
   public:
     AnnotatePlacement_Position(mabe::MABE & control,
@@ -31,6 +32,9 @@ namespace mabe {
     }
     ~AnnotatePlacement_Position() { }
 
+    /// Set which population(s) to annotate (normally done through the "target" config setting).
+    void SetTarget(const Collection & in_target) { target_collect = in_target; }
+
     /// Set up variables for configuration file
     void SetupConfig() override {
       LinkCollection(target_collect, "target", "Population(s) to annotate.");
@@ -42,11 +46,24 @@ namespace mabe {
       AddSharedTrait<OrgPosition>(pos_trait, "Organism's position in the population", {});
     }
 
-    /// When an organism is placed (via birth or inject), store its position as a trait
-    void OnPlacement(OrgPosition pos) override {
-      if(target_collect.HasPopulation(*pos.PopPtr())){
-        Organism& org = pos.PopPtr()->At(pos.Pos());
-        org.SetTrait<OrgPosition>(pos_trait, pos);
+    /// When organisms are placed (via birth or inject), store their positions as a trait
+    void OnPlacementBatch(std::span<const OrgPosition> positions) override {
+      emp::Ptr<Population> cur_pop = nullptr;    // Population whose info is currently loaded.
+      bool in_target = false;                    // Is cur_pop part of the target collection?
+      for (OrgPosition pos : positions) {
+        if (pos.PopPtr() != cur_pop) {
+          cur_pop = pos.PopPtr();
+          in_target = target_collect.HasPopulation(*cur_pop);
+        }
+        if (in_target) pos_handle(cur_pop->At(pos.Pos())) = pos;
+      }
+    }
+
+    /// When a whole population is moved, update all stored positions in a single pass.
+    void OnPopReplace(Population & to_pop, Population & /*from_pop*/) override {
+      if (!target_collect.HasPopulation(to_pop) || to_pop.GetNumOrgs() == 0) return;
+      for (size_t pos : to_pop.GetLivingPositions()) {
+        pos_handle(to_pop[pos]) = to_pop.IteratorAt(pos).AsPosition();
       }
     }
 
@@ -65,12 +65,14 @@ namespace mabe {
     OrgPosition PlaceBirth(OrgPosition ppos, Population & target_pop) {
       // If the current position is monitored, return a random place in the population.
       if (target_collect.HasPopulation(target_pop)) {
-        OrgPosition new_pos = 
-            OrgPosition(target_pop, control.GetRandom().GetUInt(target_pop.GetSize()));
-        while(new_pos == ppos){ // Do not allow parent to be replaced
-          new_pos =OrgPosition(target_pop, control.GetRandom().GetUInt(target_pop.GetSize()));
-        }
-        return new_pos;
+        // Do not allow parent to be replaced: if the parent is in this population, draw from
+        // one fewer position and skip over the parent's position.
+        const bool parent_in_pop = ppos.IsInPop(target_pop);
+        const size_t num_choices = target_pop.GetSize() - (parent_in_pop ? 1 : 0);
+        if (num_choices == 0) return OrgPosition();
+        size_t new_pos = control.GetRandom().GetUInt(num_choices);
+        if (parent_in_pop && new_pos >= ppos.Pos()) ++new_pos;
+        return OrgPosition(target_pop, new_pos);
       }
 
       // Otherwise, don't find a legal place!
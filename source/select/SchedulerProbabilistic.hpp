@@ -5,13 +5,26 @@
  *
  *  @file  SchedulerProbabilistic.h
  *  @brief Rations out updates to organisms based on a specified attribute, using a method akin to roulette selection. 
+ *
+ *  Two modes are available:
+ *  - per_step: every time step goes to an organism chosen by roulette selection, so each
+ *    step costs a random draw and a walk of the weight tree.
+ *  - time_slice: as in Avida, each round's steps are divided up in proportion to weight in a
+ *    single pass, and each organism then runs its whole slice at once.  Each organism gets the
+ *    expected number of steps rounded (randomly) up or down, so averages match per_step mode.
+ *    A slice is interrupted when the organism reproduces (see OrgType::EndTimeSlice()), since
+ *    its offspring may have replaced it; the rest of the slice then goes to whichever
+ *    organism occupies the position, so no steps are lost.
  **/
 
 #ifndef MABE_SCHEDULER_PROB_H
 #define MABE_SCHEDULER_PROB_H
 
+#include <cmath>
+
 #include "../core/MABE.hpp"
 #include "../core/Module.hpp"
+#include "../core/Serialize.hpp"
 #include "emp/datastructs/UnorderedIndexMap.hpp"
 
 namespace mabe {
@@ -19,13 +32,22 @@ namespace mabe {
   /// Rations out updates to organisms based on a specified attribute, using a method akin to roulette selection  
   class SchedulerProbabilistic : public Module {
   private:
+    enum Mode {
+      PER_STEP,
+      TIME_SLICE
+    };
+
+    Mode mode = Mode::PER_STEP; ///< How should updates be handed out?
     std::string trait = "merit";  ///< Which trait should we select on?
     std::string reset_self_trait = "reset_self";  ///< What should we call the trait used to track resetting?
     double avg_updates = 0; ///< How many updates should organisms receive on average?
     int pop_id = 0;     ///< Which population are we selecting from?
     emp::UnorderedIndexMap weight_map; ///< Data structure storing all organism fitnesses
+    emp::vector<size_t> slice_sizes; ///< Steps for each position this round (time_slice mode)
     double base_value = 1; ///< Fitness value that all organisms start with 
     double merit_scale_factor = 1; ///< Fitness = base_value + (merit * this value)
+    TraitHandle<double> trait_handle{this, trait};
+    TraitHandle<bool> reset_self_handle{this, reset_self_trait};
   public:
     SchedulerProbabilistic(mabe::MABE & control,
                      const std::string & name="SchedulerProbabilistic",
@@ -39,10 +61,19 @@ namespace mabe {
     }
     ~SchedulerProbabilistic() { }
 
+    /// Choose between time_slice mode (true) and per_step mode (false).
+    SchedulerProbabilistic & SetTimeSlice(bool in=true) {
+      mode = in ? Mode::TIME_SLICE : Mode::PER_STEP;
+      return *this;
+    }
+
     /// Set up variables for configuration file
     void SetupConfig() override {
       LinkPop(pop_id, "pop", "Which population should we select parents from?");
       LinkVar(avg_updates, "avg_updates", "How many updates should organism receive on average?");
+      LinkMenu(mode, "mode", "How should updates be handed out?",
+        Mode::PER_STEP, "per_step", "Pick the organism for each step by roulette selection.",
+        Mode::TIME_SLICE, "time_slice", "Divide steps in proportion to weight, run in slices.");
       LinkVar(trait, "trait", "Which trait provides the fitness value to use?");
       LinkVar(reset_self_trait, "reset_self_trait", 
           "Name of the trait tracking if an organism should reset itself");
@@ -62,6 +93,7 @@ namespace mabe {
       info.AddMemberFunction(
         "SCHEDULE",
         [](SchedulerProbabilistic & mod) {
+          auto timer = mod.Profile("SCHEDULE");
           return mod.Schedule();
         },
         "Perform one round of scheduling");
@@ -80,6 +112,7 @@ namespace mabe {
       }
 
       if(weight_map.GetSize() == 0) weight_map.Resize(N, base_value);
+      if(mode == Mode::TIME_SLICE) return ScheduleSlices(pop, random);
       size_t selected_idx;
       // Dole out updates
       for(size_t i = 0; i < N * avg_updates; ++i){
@@ -93,6 +126,57 @@ namespace mabe {
       return weight_map.GetWeight();
     }
 
+    /// Divide this round's steps among organisms in proportion to their weights, in a single
+    /// pass, and then run each organism's slice in one call.
+    double ScheduleSlices(Population & pop, emp::Random & random) {
+      const size_t N = pop.GetSize();
+      const double total_steps = (double) N * avg_updates;
+      const double total_weight = weight_map.GetWeight();
+
+      slice_sizes.resize(N);
+      for(size_t pos = 0; pos < N; ++pos){
+        double expected = total_steps / (double) N;  // No weights -> divide evenly
+        if(total_weight > 0.0){
+          const double weight = (pos < weight_map.GetSize()) ? weight_map.GetWeight(pos) : 0.0;
+          expected = total_steps * weight / total_weight;
+        }
+        const double whole_steps = std::floor(expected);
+        slice_sizes[pos] = (size_t) whole_steps + random.P(expected - whole_steps);
+      }
+
+      // Start from a random position so no organism always runs first.
+      const size_t start_pos = random.GetUInt(N);
+      for(size_t offset = 0; offset < N; ++offset){
+        const size_t pos = (start_pos + offset) % N;
+        // A slice that ends early (on reproduction) goes on with whoever now occupies this
+        // position: the parent if it survived, otherwise the offspring that replaced it.
+        size_t steps_left = slice_sizes[pos];
+        while(steps_left && pop.IsOccupied(pos)){
+          const size_t steps_run = pop[pos].ProcessSteps(steps_left);
+          if(steps_run == 0) break;  // This organism cannot run.
+          steps_left -= steps_run;
+        }
+      }
+      return weight_map.GetWeight();
+    }
+
+    /// Save the weight of every position for a checkpoint.
+    bool SaveState(std::ostream & os) const override {
+      emp::vector<double> weights(weight_map.GetSize());
+      for (size_t i = 0; i < weights.size(); ++i) weights[i] = weight_map.GetWeight(i);
+      BinaryWrite(os, weights);
+      return true;
+    }
+
+    /// Restore weights from a checkpoint (replacing those set as organisms were placed).
+    bool LoadState(std::istream & is) override {
+      emp::vector<double> weights;
+      if (!BinaryRead(is, weights)) return false;
+      weight_map.Resize(weights.size(), 0.0);
+      for (size_t i = 0; i < weights.size(); ++i) weight_map.Adjust(i, weights[i]);
+      return true;
+    }
+
     /// When an organism is placed in a population, add its weight to the weight map
     void OnPlacement(OrgPosition placement_pos) override {
       Population & pop = placement_pos.Pop();
@@ -101,9 +185,9 @@ namespace mabe {
         weight_map.Resize(N, 1);
       }
       size_t org_idx = placement_pos.Pos();
-      weight_map.Adjust(org_idx, 
-          base_value + merit_scale_factor * placement_pos.Pop()[org_idx].GetTrait<double>(trait));
-      placement_pos.Pop()[org_idx].SetTrait<bool>(reset_self_trait, false);
+      Organism & org = pop[org_idx];
+      weight_map.Adjust(org_idx, base_value + merit_scale_factor * trait_handle.Read(org));
+      reset_self_handle(org) = false;
     }
   };
 
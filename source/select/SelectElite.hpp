@@ -33,13 +33,13 @@ namespace mabe {
       }
 
       // Loop through the IDs in fitness order (from highest), replicating each
-      Collection placement_list;
+      emp::vector<std::pair<OrgPosition,size_t>> parents;
       for (auto it = id_fit_map.crvbegin(); it != id_fit_map.crvend() && top_count; it++) {
         size_t copy_count = std::ceil(((double)num_births) / (double) top_count--);
         num_births -= copy_count;
-        placement_list += control.Replicate(it->first, birth_pop, copy_count);
+        parents.emplace_back(it->first, copy_count);
       }
-      return placement_list;
+      return control.DoBirths(parents, birth_pop);
     }
 
   public:
@@ -59,6 +59,7 @@ namespace mabe {
       info.AddMemberFunction(
         "SELECT",
         [](SelectElite & mod, Population & from, Population & to, double count) {
+          auto timer = mod.Profile("SELECT");
           return mod.Select(from,to,count);
         },
         "Perform elite selection on the provided organisms.");
@@ -55,6 +55,7 @@ namespace mabe {
       info.AddMemberFunction(
         "SELECT",
         [](SelectFitnessSharing & mod, Population & from, Population & to, double count) {
+          auto timer = mod.Profile("SELECT");
           return mod.Select(from,to,count);
         },
         "Perform fitness sharing selection on the provided organisms.");
@@ -146,6 +146,7 @@ namespace mabe {
       info.AddMemberFunction(
         "SELECT",
         [](SelectLexicase & mod, Population & from, Population & to, double count) {
+          auto timer = mod.Profile("SELECT");
           return mod.Select(from,to,count);
         },
         "Perform lexicase selection on the identified population.");
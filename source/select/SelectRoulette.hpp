@@ -37,15 +37,14 @@ namespace mabe {
         fit_map[org_pos] = fit_fun(select_pop[org_pos]);
       }
 
-      // Loop through picking IDs proportional to fitness_trait, replicating each
+      // Pick IDs proportional to fitness_trait, replicating each
       emp::Random & random = control.GetRandom();
-      Collection placement_list;
-      for (size_t birth_id = 0; birth_id < num_births; birth_id++) {
+      auto pick_org = [&]() {
         size_t org_id = fit_map.Index( random.GetDouble(fit_map.GetWeight()) );
-        placement_list += control.Replicate(select_pop.IteratorAt(org_id), birth_pop);
-      }
+        return select_pop.IteratorAt(org_id).AsPosition();
+      };
 
-      return placement_list;
+      return control.DoBirths(num_births, pick_org, birth_pop, false);
     }
 
   public:
@@ -64,6 +63,7 @@ namespace mabe {
       info.AddMemberFunction(
         "SELECT",
         [](SelectRoulette & mod, Population & from, Population & to, double count) {
+          auto timer = mod.Profile("SELECT");
           return mod.Select(from,to,count);
         },
         "Perform roulette selection on the provided organisms.");
@@ -23,7 +23,6 @@ namespace mabe {
 
     Collection Select(Population & select_pop, Population & birth_pop, size_t num_births) {
       emp::Random & random = control.GetRandom();
-      const size_t N = select_pop.GetSize();
 
       if (select_pop.GetNumOrgs() == 0) {
         emp::notify::Error("Trying to run Tournament Selection on an Empty Population.");
@@ -33,20 +32,17 @@ namespace mabe {
       // Setup the fitness function - redo this each time in case it changes.
       auto fit_fun = control.BuildTraitEquation(select_pop, fit_equation);
 
-      // Track where all organisms are placed.
-      Collection placement_list;
-
-      // Loop through each round of tournament selection.
-      for (size_t round = 0; round < num_births; round++) {
+      // Run one round of tournament selection before each birth.  If offspring go back into
+      // the population being selected from, each one must be in place before the next round.
+      auto run_tournament = [&]() {
         // Find a random organism in the population and call it "best"
-        size_t best_id = random.GetUInt(N);
-        while (select_pop[best_id].IsEmpty()) best_id = random.GetUInt(N); // @CAO: better way for sparse pop?
+        const size_t num_orgs = select_pop.GetNumOrgs();
+        size_t best_id = select_pop.GetLivingPos(random.GetUInt(num_orgs));
         double best_fit = fit_fun(select_pop[best_id]);
 
         // Loop through other organisms for the rest of the tournament size, and pick best.
         for (size_t test=1; test < tourny_size; test++) {
-          size_t test_id = random.GetUInt(N);
-          while (select_pop[test_id].IsEmpty()) test_id = random.GetUInt(N);
+          size_t test_id = select_pop.GetLivingPos(random.GetUInt(num_orgs));
           double test_fit = fit_fun(select_pop[test_id]);          
           if (test_fit > best_fit) {
             best_id = test_id;
@@ -55,10 +51,10 @@ namespace mabe {
         }
 
         // Replicate the organism that did best in this tournament.
-        placement_list += control.Replicate(select_pop.IteratorAt(best_id), birth_pop, 1);
-      }
+        return select_pop.IteratorAt(best_id).AsPosition();
+      };
 
-      return placement_list;
+      return control.DoBirths(num_births, run_tournament, birth_pop, &select_pop == &birth_pop);
     }
 
   public:
@@ -79,6 +75,7 @@ namespace mabe {
       info.AddMemberFunction(
         "SELECT",
         [](SelectTournament & mod, Population & from, Population & to, double count) {
+          auto timer = mod.Profile("SELECT");
           return mod.Select(from,to,count);
         },
         "Perform tournament selection on the provided organisms.");
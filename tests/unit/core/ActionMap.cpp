@@ -4,7 +4,7 @@
  *  @date 2019-2021.
  *
  *  @file  ActionMap.cpp
- *  @brief TODO. Currently this is a placeholder so codecov will see the untested source code
+ *  @brief Tests for ActionMap, including dispatch of multi-function actions.
  */
 
 // CATCH
@@ -15,3 +15,34 @@
 
 
 TEST_CASE("ActionMap_Placeholder", "[core]"){ ; }
+
+TEST_CASE("ActionMap_BuildDispatch", "[core]"){
+  mabe::ActionMap action_map;
+  emp::vector<int> calls;
+  std::function<void(int)> first = [&calls](int x){ calls.push_back(x); };
+  std::function<void(int)> second = [&calls](int x){ calls.push_back(10 * x); };
+
+  { // A single function is called directly
+    mabe::Action & action = action_map.AddFunc<void, int>("single", first);
+    std::function<void(int)> dispatch = action.BuildDispatch<int>();
+    dispatch(3);
+    CHECK(calls == emp::vector<int>{3});
+  }
+  calls.clear();
+  { // Multiple functions are run in the order they were added
+    action_map.AddFunc<void, int>("multi", first);
+    mabe::Action & action = action_map.AddFunc<void, int>("multi", second);
+    CHECK(action.function_vec.size() == 2);
+    std::function<void(int)> dispatch = action.BuildDispatch<int>();
+    dispatch(2);
+    CHECK(calls == emp::vector<int>({2, 20}));
+  }
+  calls.clear();
+  { // Functions without a known type still work, via AnyFunction
+    mabe::Action action("untyped", emp::AnyFunction(second));
+    action.function_vec.emplace_back(first);
+    std::function<void(int)> dispatch = action.BuildDispatch<int>();
+    dispatch(4);
+    CHECK(calls == emp::vector<int>({40, 4}));
+  }
+}
@@ -1,17 +1,87 @@
 /**
  *  @note This file is part of MABE, https://github.com/mercere99/MABE2
  *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
- *  @date 2019-2021.
+ *  @date 2019-2022.
  *
  *  @file  Collection.cpp
- *  @brief TODO. Currently this is a placeholder so codecov will see the untested source code
+ *  @brief Tests for collections of organism positions.
  */
 
+#include <utility>
+
 // CATCH
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
 // MABE
 #include "core/Collection.hpp"
+#include "core/MABE.hpp"
+#include "core/OrganismManager.hpp"
+#include "orgs/BitsOrg.hpp"
+
+TEST_CASE("Collection_IteratorAt", "[core]"){
+  mabe::MABE control(0, nullptr);
+  control.AddModule<mabe::OrganismManager<mabe::BitsOrg>>("BitsOrg", "Test organisms.");
+  mabe::Population & empty_pop = control.AddPopulation("empty_pop");
+  mabe::Population & pop1 = control.AddPopulation("pop1");
+  mabe::Population & pop2 = control.AddPopulation("pop2");
+  control.Setup();
+  control.Inject(pop1, "BitsOrg", 10);
+  control.Inject(pop2, "BitsOrg", 4);
+
+  // An empty population has nothing to index.
+  {
+    mabe::Collection collect(empty_pop);
+    CHECK(collect.GetSize() == 0);
+    CHECK(collect.IteratorAt(0) == collect.end());
+    mabe::Collection alive = collect.GetAlive();
+    CHECK(alive.IteratorAt(0) == alive.end());
+  }
+
+  // Clear some cells, including the first and last.
+  for (size_t pos : {0, 3, 4, 9}) control.ClearOrgAt(pop1.IteratorAt(pos));
+  control.ClearOrgAt(pop2.IteratorAt(1));
+
+  // A whole population includes its empty cells.
+  {
+    mabe::Collection collect(pop1);
+    CHECK(collect.GetSize() == 10);
+    CHECK(collect.IteratorAt(3).Pos() == 3);
+    CHECK(collect.IteratorAt(9).Pos() == 9);
+    CHECK(collect.IteratorAt(10) == collect.end());
+    CHECK(collect.IteratorAt(1000) == collect.end());
+  }
 
+  // Living organisms only: indices skip over the empty cells.
+  {
+    mabe::Collection alive = mabe::Collection(pop1).GetAlive();
+    const emp::vector<size_t> expected{1, 2, 5, 6, 7, 8};
+    REQUIRE(alive.GetSize() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      auto it = alive.IteratorAt(i);
+      CHECK(it.PopPtr() == &pop1);
+      CHECK(it.Pos() == expected[i]);
+      CHECK(!it->IsEmpty());
+      CHECK(&alive.At(i) == &pop1[expected[i]]);
+    }
+    CHECK(alive.IteratorAt(expected.size()) == alive.end());
+  }
 
-TEST_CASE("Collection_Placeholder", "[core]"){ ; }
+  // Indices continue from one population into the next.
+  {
+    mabe::Collection alive = mabe::Collection(pop1, pop2).GetAlive();
+    REQUIRE(alive.GetSize() == 9);
+    emp::vector<std::pair<emp::Ptr<const mabe::Population>, size_t>> found;
+    for (size_t i = 0; i < alive.GetSize(); ++i) {
+      auto it = std::as_const(alive).IteratorAt(i);
+      found.emplace_back(it.PopPtr(), it.Pos());
+    }
+    size_t count1 = 0;
+    for (auto [pop_ptr, pos] : found) {
+      CHECK(!pop_ptr->At(pos).IsEmpty());
+      if (pop_ptr == &pop1) count1++;
+    }
+    CHECK(count1 == 6);
+    CHECK(alive.IteratorAt(9) == alive.end());
+    CHECK(alive.IteratorAt(100) == alive.end());
+  }
+}
@@ -0,0 +1,80 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  EquationVM.cpp
+ *  @brief Tests for compiling trait equations to bytecode.
+ */
+
+#include <cmath>
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// Empirical
+#include "emp/base/vector.hpp"
+#include "emp/data/DataMap.hpp"
+// MABE
+#include "core/EquationVM.hpp"
+
+TEST_CASE("EquationVM_Compile", "[core]"){
+  emp::DataMap dm;
+  dm.AddVar<double>("fitness", 2.5);
+  dm.AddVar<int>("age", 4);
+  dm.AddVar<bool>("alive", true);
+  dm.AddVar<std::string>("name", "org");
+  dm.LockLayout();
+  const emp::vector<double> preserved{10.0};
+
+  auto eval = [&](const std::string & equation) {
+    mabe::EquationProgram prog;
+    REQUIRE(prog.Compile(dm.GetLayout(), equation, preserved));
+    return prog.Run(dm);
+  };
+
+  CHECK(eval("1 + 2 * 3") == 7.0);
+  CHECK(eval("(1 + 2) * 3") == 9.0);
+  CHECK(eval("10 - 4 - 3") == 3.0);              // Left associative.
+  CHECK(eval("-fitness * 2") == -5.0);
+  CHECK(eval("fitness * age + $0") == 20.0);
+  CHECK(eval("age > 3 && alive") == 1.0);
+  CHECK(eval("age <= 3 || !alive") == 0.0);
+  CHECK(eval("age == 4") == 1.0);
+  CHECK(eval("MAX(fitness, age) + MIN(1, 2)") == 5.0);
+  CHECK(eval("IF(age > 10, 1, SQRT(16))") == 4.0);
+  CHECK(eval("POW(2, 10) + ABS(-1) + FLOOR(2.5) + CEIL(2.5)") == 1030.0);
+  CHECK(eval("1.5e2") == 150.0);
+
+  // Anything not supported should be left for the general parser.
+  mabe::EquationProgram prog;
+  CHECK(prog.Compile(dm.GetLayout(), "name", preserved) == false);      // Not numeric.
+  CHECK(prog.Compile(dm.GetLayout(), "missing + 1", preserved) == false);
+  CHECK(prog.Compile(dm.GetLayout(), "fitness % 2", preserved) == false);
+  CHECK(prog.Compile(dm.GetLayout(), "RAND()", preserved) == false);
+  CHECK(prog.Compile(dm.GetLayout(), "(1 + 2", preserved) == false);
+  CHECK(prog.Compile(dm.GetLayout(), "$1", preserved) == false);
+  CHECK(prog.Compile(dm.GetLayout(), "", preserved) == false);
+  CHECK(prog.IsCompiled() == false);
+}
+
+TEST_CASE("EquationVM_Batch", "[core]"){
+  emp::DataMap base_dm;
+  const size_t fit_id = base_dm.AddVar<double>("fitness", 0.0);
+  base_dm.AddVar<int>("age", 1);
+  base_dm.LockLayout();
+
+  emp::vector<emp::DataMap> dms(1000, base_dm);
+  for (size_t i = 0; i < dms.size(); ++i) dms[i].Get<double>(fit_id) = (double) i;
+
+  mabe::EquationProgram prog;
+  REQUIRE(prog.Compile(base_dm.GetLayout(), "fitness * 2 + age", {}));
+  emp::vector<double> results(dms.size());
+  prog.RunBatch(dms.size(), [&dms](size_t i) -> const emp::DataMap & { return dms[i]; },
+                results.data());
+  bool all_match = true;
+  for (size_t i = 0; i < dms.size(); ++i) {
+    if (results[i] != prog.Run(dms[i]) || results[i] != 2.0 * i + 1.0) all_match = false;
+  }
+  CHECK(all_match);
+}
@@ -4,7 +4,7 @@
  *  @date 2019-2021.
  *
  *  @file  MABE.cpp
- *  @brief TODO. Currently this is a placeholder so codecov will see the untested source code
+ *  @brief Tests for the main MABE controller.
  */
 
 // CATCH
@@ -12,6 +12,100 @@
 #include "catch.hpp"
 // MABE
 #include "core/MABE.hpp"
+#include "core/OrganismManager.hpp"
+#include "orgs/BitsOrg.hpp"
 
+// Run the same set of births either all at once with DoBirths() or one at a time with
+// Replicate(); record the positions that received offspring and the final genomes.
+struct BirthResults {
+  std::string births;
+  emp::vector<std::string> genomes;
+};
 
-TEST_CASE("MABE_Placeholder", "[core]"){ ; }
+static BirthResults RunBirths(bool batched, size_t birth_count) {
+  mabe::MABE control(0, nullptr);
+  control.AddModule<mabe::OrganismManager<mabe::BitsOrg>>("BitsOrg", "Test organisms.");
+  mabe::Population & pop = control.AddPopulation("main_pop");
+  control.Setup();
+  control.GetRandom().ResetSeed(42);
+  control.Inject(pop, "BitsOrg", 40);
+
+  // Random placement that can hit a parent or a position that already has a new offspring.
+  // With multiple offspring, an organism should not replace its own parent mid-birth.
+  pop.SetPlaceBirthFun([&control, &pop, birth_count](mabe::Organism &, mabe::OrgPosition ppos) {
+    size_t pos = control.GetRandom().GetUInt(pop.GetSize());
+    while (birth_count > 1 && pos == ppos.Pos()) pos = control.GetRandom().GetUInt(pop.GetSize());
+    return mabe::OrgPosition(pop, pos);
+  });
+
+  emp::vector<std::pair<mabe::OrgPosition,size_t>> parents;
+  for (size_t i = 0; i < 100; ++i) {
+    const size_t parent_id = control.GetRandom().GetUInt(pop.GetSize());
+    parents.emplace_back(pop.IteratorAt(parent_id).AsPosition(), birth_count);
+  }
+
+  mabe::Collection births;
+  if (batched) births = control.DoBirths(parents, pop);
+  else for (auto [ppos, count] : parents) births += control.Replicate(ppos, pop, count);
+
+  BirthResults results;
+  results.births = births.ToString();
+  for (size_t pos = 0; pos < pop.GetSize(); ++pos) results.genomes.push_back(pop[pos].ToString());
+  return results;
+}
+
+TEST_CASE("MABE_DoBirths", "[core]"){
+  // Batched births must match sequential births with the same seed, including when offspring
+  // replace parents that have not reproduced yet or land on the same position twice.
+  {
+    BirthResults batched = RunBirths(true, 1);
+    BirthResults sequential = RunBirths(false, 1);
+    CHECK(batched.births == sequential.births);
+    CHECK(batched.genomes == sequential.genomes);
+  }
+
+  // Same with multiple offspring per parent.
+  {
+    BirthResults batched = RunBirths(true, 3);
+    BirthResults sequential = RunBirths(false, 3);
+    CHECK(batched.births == sequential.births);
+    CHECK(batched.genomes == sequential.genomes);
+  }
+}
+
+// Choose each parent right before its birth (as selection modules do), either through
+// DoBirths() or by calling Replicate() after each choice.
+static BirthResults RunChosenBirths(bool batched) {
+  mabe::MABE control(0, nullptr);
+  control.AddModule<mabe::OrganismManager<mabe::BitsOrg>>("BitsOrg", "Test organisms.");
+  mabe::Population & pop = control.AddPopulation("main_pop");
+  control.Setup();
+  control.GetRandom().ResetSeed(42);
+  control.Inject(pop, "BitsOrg", 40);
+
+  // The chooser draws random numbers and looks at the current organisms (like a tournament),
+  // so it must see every earlier offspring in place.
+  auto choose_parent = [&control, &pop]() {
+    size_t pos1 = control.GetRandom().GetUInt(pop.GetSize());
+    size_t pos2 = control.GetRandom().GetUInt(pop.GetSize());
+    if (pop[pos2].ToString() > pop[pos1].ToString()) pos1 = pos2;
+    return pop.IteratorAt(pos1).AsPosition();
+  };
+
+  mabe::Collection births;
+  if (batched) births = control.DoBirths(100, choose_parent, pop, true);
+  else for (size_t i = 0; i < 100; ++i) births += control.Replicate(choose_parent(), pop);
+
+  BirthResults results;
+  results.births = births.ToString();
+  for (size_t pos = 0; pos < pop.GetSize(); ++pos) results.genomes.push_back(pop[pos].ToString());
+  return results;
+}
+
+TEST_CASE("MABE_DoBirthsChosen", "[core]"){
+  // Random draws for choosing parents and for births must interleave as they do sequentially.
+  BirthResults batched = RunChosenBirths(true);
+  BirthResults sequential = RunChosenBirths(false);
+  CHECK(batched.births == sequential.births);
+  CHECK(batched.genomes == sequential.genomes);
+}
@@ -4,7 +4,7 @@
  *  @date 2019-2021.
  *
  *  @file  MABEBase.cpp
- *  @brief TODO. Currently this is a placeholder so codecov will see the untested source code
+ *  @brief Tests for population management in MABEBase.
  */
 
 // CATCH
@@ -12,6 +12,65 @@
 #include "catch.hpp"
 // MABE
 #include "core/MABEBase.hpp"
+#include "core/MABE.hpp"
+#include "core/OrganismManager.hpp"
+#include "orgs/BitsOrg.hpp"
+#include "placement/AnnotatePlacement_Position.hpp"
 
 
-TEST_CASE("MABEBase_Placeholder", "[core]"){ ; }
+TEST_CASE("MABEBase_ReplacePop", "[core]"){
+  mabe::MABE control(0, nullptr);
+  control.AddModule<mabe::OrganismManager<mabe::BitsOrg>>("BitsOrg", "Test organisms.");
+  mabe::Population & to_pop = control.AddPopulation("to_pop");
+  mabe::Population & from_pop = control.AddPopulation("from_pop");
+  auto & annotate = control.AddModule<mabe::AnnotatePlacement_Position>("annotate");
+  annotate.SetTarget(mabe::Collection(to_pop));
+  control.Setup();
+
+  // Fill both populations, then leave gaps in from_pop so the living index matters.
+  control.Inject(to_pop, "BitsOrg", 10);
+  control.Inject(from_pop, "BitsOrg", 20);
+  control.ClearOrgAt(mabe::OrgPosition(from_pop, 3));
+  control.ClearOrgAt(mabe::OrgPosition(from_pop, 7));
+  REQUIRE(from_pop.GetNumOrgs() == 18);
+
+  emp::vector<std::string> from_genomes;
+  for (size_t pos = 0; pos < from_pop.GetSize(); ++pos) {
+    from_genomes.push_back(from_pop[pos].ToString());
+  }
+
+  control.ReplacePop(to_pop, from_pop);
+
+  // from_pop is left empty with size zero.
+  CHECK(from_pop.GetSize() == 0);
+  CHECK(from_pop.GetNumOrgs() == 0);
+  CHECK(from_pop.GetLivingPositions().size() == 0);
+
+  // to_pop now holds exactly the organisms from from_pop, in the same positions.
+  CHECK(to_pop.GetSize() == 20);
+  CHECK(to_pop.GetNumOrgs() == 18);
+  for (size_t pos = 0; pos < to_pop.GetSize(); ++pos) {
+    CHECK(to_pop[pos].ToString() == from_genomes[pos]);
+    CHECK(to_pop.IsEmpty(pos) == (pos == 3 || pos == 7));
+  }
+
+  // The living index lists each living position exactly once.
+  const emp::vector<size_t> & living = to_pop.GetLivingPositions();
+  CHECK(living.size() == 18);
+  emp::BitVector seen(to_pop.GetSize());
+  for (size_t pos : living) {
+    CHECK(!to_pop.IsEmpty(pos));
+    CHECK(!seen.Has(pos));
+    seen.Set(pos);
+  }
+  for (size_t id = 0; id < to_pop.GetNumOrgs(); ++id) {
+    CHECK(!to_pop.IsEmpty(to_pop.GetLivingPos(id)));
+  }
+
+  // OnPopReplace updated each stored position to the organism's place in to_pop.
+  for (size_t pos : living) {
+    const mabe::OrgPosition & org_pos = to_pop[pos].GetTrait<mabe::OrgPosition>("org_pos");
+    CHECK(org_pos.PopPtr() == &to_pop);
+    CHECK(org_pos.Pos() == pos);
+  }
+}
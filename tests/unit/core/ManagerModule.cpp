@@ -4,7 +4,7 @@
  *  @date 2019-2021.
  *
  *  @file  ManagerModule.cpp
- *  @brief TODO. Currently this is a placeholder so codecov will see the untested source code
+ *  @brief Tests for organism recycling in ManagerModule.
  */
 
 // CATCH
@@ -12,6 +12,86 @@
 #include "catch.hpp"
 // MABE
 #include "core/ManagerModule.hpp"
+#include "core/OrganismManager.hpp"
+#include "orgs/BitsOrg.hpp"
 
 
-TEST_CASE("ManagerModule_Placeholder", "[core]"){ ; }
+TEST_CASE("ManagerModule_Recycling", "[core]"){
+  mabe::MABE control(0, nullptr);
+  control.AddPopulation("test_pop");
+  mabe::OrganismManager<mabe::BitsOrg> manager(control, "bits", "desc");
+  mabe::BitsOrg proto(manager);
+
+  // Warm up with a population of 100 organisms; each one must be allocated.
+  emp::vector<emp::Ptr<mabe::Organism>> orgs;
+  for (size_t i = 0; i < 100; ++i) orgs.push_back(manager.CloneObject<mabe::Organism>(proto));
+  CHECK(manager.GetNumAllocs() == 100);
+  CHECK(manager.GetNumReuses() == 0);
+
+  // Steady state: 10,000 birth/death pairs (one dies, one is born from a parent).
+  // With recycling no further allocations are needed (see below for the count without).
+  for (size_t i = 0; i < 10000; ++i) {
+    const size_t id = (i * 37) % orgs.size();
+    manager.RecycleObject(orgs[id]);
+    orgs[id] = manager.CloneObject<mabe::Organism>(*orgs[(id + 1) % orgs.size()]);
+  }
+  CHECK(manager.GetNumAllocs() == 100);
+  CHECK(manager.GetNumReuses() == 10000);
+  CHECK(manager.GetNumRecycled() == 0);
+
+  // Reused objects still belong to this manager.
+  for (auto org_ptr : orgs) CHECK(&org_ptr->GetManager() == &manager);
+
+  for (auto org_ptr : orgs) manager.RecycleObject(org_ptr);
+  CHECK(manager.GetNumRecycled() == 100);
+}
+
+TEST_CASE("ManagerModule_RecyclingDisabled", "[core]"){
+  mabe::MABE control(0, nullptr);
+  control.AddPopulation("test_pop");
+  mabe::OrganismManager<mabe::BitsOrg> manager(control, "bits", "desc");
+  mabe::BitsOrg proto(manager);
+  manager.SetMaxRecycled(0);
+
+  // The same steady state as above, but every dead organism is deleted.
+  emp::vector<emp::Ptr<mabe::Organism>> orgs;
+  for (size_t i = 0; i < 100; ++i) orgs.push_back(manager.CloneObject<mabe::Organism>(proto));
+  for (size_t i = 0; i < 10000; ++i) {
+    const size_t id = (i * 37) % orgs.size();
+    manager.RecycleObject(orgs[id]);
+    orgs[id] = manager.CloneObject<mabe::Organism>(*orgs[(id + 1) % orgs.size()]);
+  }
+  CHECK(manager.GetNumAllocs() == 10100);
+  CHECK(manager.GetNumReuses() == 0);
+  CHECK(manager.GetNumRecycled() == 0);
+
+  for (auto org_ptr : orgs) manager.RecycleObject(org_ptr);
+  CHECK(manager.GetNumRecycled() == 0);
+}
+
+TEST_CASE("ManagerModule_RecyclingCap", "[core]"){
+  mabe::MABE control(0, nullptr);
+  control.AddPopulation("test_pop");
+  mabe::OrganismManager<mabe::BitsOrg> manager(control, "bits", "desc");
+  mabe::BitsOrg proto(manager);
+
+  // The recycled list never holds more than the peak number of live objects.
+  emp::vector<emp::Ptr<mabe::Organism>> orgs;
+  for (size_t i = 0; i < 10; ++i) orgs.push_back(manager.CloneObject<mabe::Organism>(proto));
+  for (auto org_ptr : orgs) manager.RecycleObject(org_ptr);
+  CHECK(manager.GetNumRecycled() == 10);
+
+  // Extra objects beyond that peak are deleted rather than held.
+  auto extra = emp::NewPtr<mabe::BitsOrg>(proto);
+  manager.RecycleObject(extra);
+  CHECK(manager.GetNumRecycled() == 10);
+
+  // A user limit trims the existing list and caps it from then on.
+  manager.SetMaxRecycled(4);
+  CHECK(manager.GetNumRecycled() == 4);
+  orgs.resize(0);
+  for (size_t i = 0; i < 8; ++i) orgs.push_back(manager.CloneObject<mabe::Organism>(proto));
+  CHECK(manager.GetNumReuses() == 4);
+  for (auto org_ptr : orgs) manager.RecycleObject(org_ptr);
+  CHECK(manager.GetNumRecycled() == 4);
+}
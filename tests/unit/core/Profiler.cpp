@@ -0,0 +1,69 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  Profiler.cpp
+ *  @brief Tests for signal and script-call profiling.
+ */
+
+#include <sstream>
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// MABE
+#include "core/Profiler.hpp"
+
+
+TEST_CASE("Profiler_Inactive", "[core]"){
+  mabe::Profiler profiler;
+  CHECK(profiler.IsActive() == false);
+
+  // Inactive profilers should not record anything.
+  {
+    mabe::Profiler::Timer timer = profiler.StartTimer("mod", "EVAL");
+    profiler.CountAlloc();
+  }
+  CHECK(profiler.GetNumEntries() == 0);
+}
+
+TEST_CASE("Profiler_Active", "[core]"){
+  mabe::Profiler profiler;
+  profiler.SetActive();
+
+  for (size_t i = 0; i < 3; ++i) {
+    mabe::Profiler::Timer timer = profiler.StartTimer("mod", "EVAL");
+    profiler.CountAlloc();
+  }
+  {
+    mabe::Profiler::Timer outer = profiler.StartTimer("mod", "SELECT");
+    mabe::Profiler::Timer inner = profiler.StartTimer("other_mod", "on_placement");
+    profiler.CountAlloc();
+    inner.Stop();
+    inner.Stop();  // A second stop should be ignored.
+    profiler.CountAlloc();
+  }
+
+  CHECK(profiler.GetNumEntries() == 3);
+
+  const mabe::Profiler::Entry & eval = profiler.GetEntry("mod", "EVAL");
+  CHECK(eval.count == 3);
+  CHECK(eval.num_allocs == 3);
+  CHECK(eval.total_time >= eval.max_time);
+
+  // Outer timers include everything nested inside of them.
+  const mabe::Profiler::Entry & select = profiler.GetEntry("mod", "SELECT");
+  const mabe::Profiler::Entry & placement = profiler.GetEntry("other_mod", "on_placement");
+  CHECK(select.count == 1);
+  CHECK(select.num_allocs == 2);
+  CHECK(placement.count == 1);
+  CHECK(placement.num_allocs == 1);
+
+  std::stringstream ss;
+  profiler.PrintReport(ss);
+  CHECK(ss.str().find("on_placement") != std::string::npos);
+
+  profiler.Reset();
+  CHECK(profiler.GetNumEntries() == 0);
+}
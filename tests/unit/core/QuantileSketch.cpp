@@ -0,0 +1,66 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  QuantileSketch.cpp
+ *  @brief Tests for approximate quantiles with bounded memory.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// Empirical
+#include "emp/base/vector.hpp"
+// MABE
+#include "core/QuantileSketch.hpp"
+#include "core/RandomStream.hpp"
+
+TEST_CASE("QuantileSketch_Small", "[core]"){
+  mabe::QuantileSketch sketch;
+  CHECK(std::isnan(sketch.GetQuantile(0.5)));
+
+  // Below capacity, quantiles are exact (the value at index floor(q*N) of the sorted values).
+  for (size_t i = 10; i > 0; --i) sketch.Insert((double) i);
+  sketch.Insert(std::nan(""));
+  CHECK(sketch.GetCount() == 10);
+  CHECK(sketch.GetQuantile(0.0) == 1.0);
+  CHECK(sketch.GetQuantile(0.5) == 6.0);
+  CHECK(sketch.GetQuantile(0.9) == 10.0);
+  CHECK(sketch.GetQuantile(1.0) == 10.0);
+
+  sketch.Clear();
+  CHECK(sketch.GetCount() == 0);
+}
+
+TEST_CASE("QuantileSketch_Large", "[core]"){
+  const size_t N = 200000;
+  mabe::RandomStream random(12345);
+  emp::vector<double> values(N);
+  for (double & value : values) value = random.GetDouble();
+
+  mabe::QuantileSketch sketch;
+  for (double value : values) sketch.Insert(value);
+  CHECK(sketch.GetCount() == N);
+  CHECK(sketch.GetNumHeld() < 1000);   // Memory stays bounded.
+
+  emp::vector<double> sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+  for (double q : {0.01, 0.1, 0.5, 0.9, 0.99}) {
+    // Find the rank of the estimate and compare it to the requested rank.
+    const double estimate = sketch.GetQuantile(q);
+    const auto pos = std::lower_bound(sorted.begin(), sorted.end(), estimate);
+    const double rank = (double) (pos - sorted.begin());
+    CHECK(std::abs(rank / N - q) < 0.02);
+  }
+  CHECK(sketch.GetQuantile(0.0) == sorted.front());
+  CHECK(sketch.GetQuantile(1.0) == sorted.back());
+
+  // The same values in the same order always give the same estimates.
+  mabe::QuantileSketch sketch2;
+  for (double value : values) sketch2.Insert(value);
+  CHECK(sketch2.GetQuantile(0.5) == sketch.GetQuantile(0.5));
+}
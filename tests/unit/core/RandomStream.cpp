@@ -0,0 +1,89 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  RandomStream.cpp
+ *  @brief Tests for counter-based random number streams.
+ */
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// Empirical
+#include "emp/base/vector.hpp"
+// MABE
+#include "core/RandomStream.hpp"
+
+
+TEST_CASE("RandomStream_Reproducible", "[core]"){
+  const uint64_t key = mabe::RandomStream::MixKeys(12345, {1, 2, 3});
+  mabe::RandomStream stream1(key);
+  mabe::RandomStream stream2(key);
+
+  // Streams with the same key produce the same draws, and any draw can be found directly.
+  for (size_t i = 0; i < 100; ++i) {
+    const uint64_t val = stream1.GetUInt64();
+    CHECK(val == stream2.GetUInt64());
+    CHECK(val == mabe::RandomStream::Draw(key, i));
+  }
+  CHECK(stream1.GetCounter() == 100);
+
+  stream2.SetCounter(10);
+  CHECK(stream2.GetUInt64() == mabe::RandomStream::Draw(key, 10));
+
+  // Changing any key (or its order) should give a different stream.
+  CHECK(mabe::RandomStream::MixKeys(12345, {1, 2, 4}) != key);
+  CHECK(mabe::RandomStream::MixKeys(12345, {2, 1, 3}) != key);
+  CHECK(mabe::RandomStream::MixKeys(12346, {1, 2, 3}) != key);
+  CHECK(stream1.GetSubstream(0).GetKey() != stream1.GetSubstream(1).GetKey());
+  CHECK(mabe::RandomStream::HashName("mod_a") != mabe::RandomStream::HashName("mod_b"));
+}
+
+TEST_CASE("RandomStream_Ranges", "[core]"){
+  mabe::RandomStream stream(42);
+  double total = 0.0;
+  size_t true_count = 0;
+  for (size_t i = 0; i < 10000; ++i) {
+    const double val = stream.GetDouble();
+    CHECK(val >= 0.0);
+    CHECK(val < 1.0);
+    total += val;
+
+    const uint64_t roll = stream.GetUInt(5, 10);
+    CHECK(roll >= 5);
+    CHECK(roll < 10);
+
+    if (stream.P(0.25)) true_count++;
+    CHECK(stream.GetSeed() > 0);
+  }
+  CHECK(total / 10000.0 == Approx(0.5).margin(0.02));
+  CHECK(true_count > 2200);
+  CHECK(true_count < 2800);
+}
+
+TEST_CASE("RandomStream_UInt", "[core]"){
+  // The portable 64x64 multiply must give the full 128-bit product.
+  uint64_t lo = 0;
+  CHECK(mabe::RandomStream::MulHiLo(~0ull, ~0ull, lo) == 0xFFFFFFFFFFFFFFFEull);
+  CHECK(lo == 1);
+  CHECK(mabe::RandomStream::MulHiLo(1ull << 32, 1ull << 32, lo) == 1);
+  CHECK(lo == 0);
+  CHECK(mabe::RandomStream::MulHiLo(0x123456789ABCDEFull, 0xFEDCBA987654321ull, lo)
+        == 0x121FA00AD77D74ull);
+  CHECK(lo == 0x22236D88FE5618CFull);
+
+  // Results must cover the range evenly, including a range that does not divide 2^64.
+  mabe::RandomStream stream(7);
+  emp::vector<size_t> counts(6, 0);
+  for (size_t i = 0; i < 60000; ++i) counts[stream.GetUInt(6)]++;
+  for (size_t count : counts) {
+    CHECK(count > 9500);
+    CHECK(count < 10500);
+  }
+  CHECK(stream.GetUInt(0) == 0);
+  CHECK(stream.GetUInt(1) == 0);
+  CHECK(stream.GetUInt(3, 3) == 3);
+  const uint64_t big = (1ull << 63) + 1;  // Draws are rejected about half the time.
+  for (size_t i = 0; i < 100; ++i) CHECK(stream.GetUInt(big) < big);
+}
@@ -0,0 +1,61 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  ReduceKernels.cpp
+ *  @brief Tests for reproducible numeric reductions.
+ */
+
+#include <cmath>
+#include <limits>
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// Empirical
+#include "emp/base/vector.hpp"
+// MABE
+#include "core/ReduceKernels.hpp"
+
+TEST_CASE("ReduceKernels_Basic", "[core]"){
+  emp::vector<double> values;
+  CHECK(mabe::Reduce::Sum(values) == 0.0);
+  CHECK(mabe::Reduce::Min(values) == std::numeric_limits<double>::max());
+  CHECK(mabe::Reduce::Max(values) == std::numeric_limits<double>::lowest());
+
+  for (size_t i = 0; i < 10; ++i) values.push_back((double) i);
+  CHECK(mabe::Reduce::Sum(values) == 45.0);
+  CHECK(mabe::Reduce::SumSquaredDev(values, 4.5) == 82.5);
+  CHECK(mabe::Reduce::Min(values) == 0.0);
+  CHECK(mabe::Reduce::Max(values) == 9.0);
+
+  // NaNs are skipped by min and max, as in a simple comparison loop.
+  values[3] = std::numeric_limits<double>::quiet_NaN();
+  CHECK(mabe::Reduce::Min(values) == 0.0);
+  CHECK(mabe::Reduce::Max(values) == 9.0);
+  double entropy = 0.0;
+  CHECK(mabe::Reduce::Entropy(values, entropy) == false);
+
+  emp::vector<double> coins{0.0, 1.0, 1.0, 0.0};
+  CHECK(mabe::Reduce::Entropy(coins, entropy) == true);
+  CHECK(entropy == 1.0);
+}
+
+TEST_CASE("ReduceKernels_Reproducible", "[core]"){
+  // Values whose sum depends on the order they are added in.
+  emp::vector<double> values(200001);
+  for (size_t i = 0; i < values.size(); ++i) values[i] = std::sin((double) i) * 1e8 + 0.1;
+
+  const double serial_sum = mabe::Reduce::Sum(values);
+  const double serial_sq = mabe::Reduce::SumSquaredDev(values, 1.0);
+
+  // Results must not depend on the number of threads used.
+  for (size_t num_threads : {2, 3, 8}) {
+    mabe::ThreadPool pool(num_threads);
+    mabe::Reduce::SetThreadPool(&pool);
+    CHECK(mabe::Reduce::Sum(values) == serial_sum);
+    CHECK(mabe::Reduce::SumSquaredDev(values, 1.0) == serial_sq);
+    mabe::Reduce::SetThreadPool(nullptr);
+  }
+}
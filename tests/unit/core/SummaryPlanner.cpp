@@ -0,0 +1,122 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  SummaryPlanner.cpp
+ *  @brief Tests for computing many population summaries in a single pass.
+ */
+
+#include <algorithm>
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// MABE
+#include "core/MABE.hpp"
+#include "core/OrganismManager.hpp"
+#include "core/SummaryPlanner.hpp"
+#include "orgs/BitsOrg.hpp"
+
+TEST_CASE("SummaryPlanner_TwoPopulations", "[core]"){
+  using ValueList = mabe::SummaryPlanner::ValueList;
+  mabe::MABE control(0, nullptr);
+  control.AddModule<mabe::OrganismManager<mabe::BitsOrg>>("BitsOrg", "Test organisms.");
+  mabe::Population & pop1 = control.AddPopulation("pop1");
+  mabe::Population & pop2 = control.AddPopulation("pop2");
+  control.Setup();
+  control.Inject(pop1, "BitsOrg", 3);
+  control.Inject(pop2, "BitsOrg", 5);
+
+  // Each organism's value is its population's size, so results identify the population.
+  size_t num_calls = 0;
+  auto get_fun = [&num_calls](const mabe::Organism & org) {
+    ++num_calls;
+    return (double) org.GetPopPtr()->GetSize();
+  };
+  auto sum_fun = [](const ValueList & values) {
+    double total = 0.0;
+    for (double val : values) total += val;
+    return emplode::Symbol_Var(total);
+  };
+  auto max_fun = [](const ValueList & values) {
+    return emplode::Symbol_Var(*std::max_element(values.begin(), values.end()));
+  };
+
+  mabe::SummaryPlanner planner;
+  const size_t sum_id = planner.AddRequest("sum", "pop_size", get_fun, sum_fun);
+  const size_t max_id = planner.AddRequest("max", "pop_size", get_fun, max_fun);
+  CHECK(planner.GetNumColumns() == 1);
+
+  CHECK(planner.GetResult(pop1, sum_id).AsDouble() == 9.0);
+  CHECK(planner.GetResult(pop2, sum_id).AsDouble() == 25.0);
+  CHECK(num_calls == 8);
+  CHECK(planner.GetNumPopulations() == 2);
+
+  // Alternating between populations must reuse each one's results rather than recompute.
+  for (size_t i = 0; i < 5; ++i) {
+    CHECK(planner.GetResult(pop1, sum_id).AsDouble() == 9.0);
+    CHECK(planner.GetResult(pop2, sum_id).AsDouble() == 25.0);
+    CHECK(planner.GetResult(pop1, max_id).AsDouble() == 3.0);  // Shares the computed column.
+    CHECK(planner.GetResult(pop2, max_id).AsDouble() == 5.0);
+  }
+  CHECK(num_calls == 8);
+
+  // Changing a population must be noticed.
+  control.Inject(pop1, "BitsOrg", 1);
+  CHECK(planner.GetResult(pop1, sum_id).AsDouble() == 16.0);
+  CHECK(planner.GetResult(pop2, sum_id).AsDouble() == 25.0);
+  const size_t changed_calls = num_calls;
+  CHECK(planner.GetResult(pop1, max_id).AsDouble() == 4.0);
+  CHECK(planner.GetResult(pop2, max_id).AsDouble() == 5.0);
+  CHECK(num_calls == changed_calls);
+}
+
+TEST_CASE("SummaryPlanner_TraitWrites", "[core]"){
+  using ValueList = mabe::SummaryPlanner::ValueList;
+  mabe::MABE control(0, nullptr);
+  control.AddModule<mabe::OrganismManager<mabe::BitsOrg>>("BitsOrg", "Test organisms.");
+  mabe::Population & pop = control.AddPopulation("pop");
+  control.Setup();
+  control.Inject(pop, "BitsOrg", 4);
+
+  // Each organism's value is the number of ones in its "bits" trait.
+  size_t num_calls = 0;
+  auto get_fun = [&num_calls](const mabe::Organism & org) {
+    ++num_calls;
+    return (double) org.GetTrait<emp::BitVector>("bits").CountOnes();
+  };
+  auto sum_fun = [](const ValueList & values) {
+    double total = 0.0;
+    for (double val : values) total += val;
+    return emplode::Symbol_Var(total);
+  };
+  auto count_ones = [&pop]() {
+    double total = 0.0;
+    for (size_t pos = 0; pos < pop.GetSize(); ++pos) {
+      const mabe::Organism & org = pop[pos];
+      total += (double) org.GetTrait<emp::BitVector>("bits").CountOnes();
+    }
+    return total;
+  };
+
+  mabe::SummaryPlanner planner;
+  const size_t sum_id = planner.AddRequest("sum", "ones", get_fun, sum_fun);
+  CHECK(planner.GetResult(pop, sum_id).AsDouble() == count_ones());
+  CHECK(num_calls == 4);
+
+  // Reading traits (without any signals or module calls) leaves the result cached.
+  CHECK(planner.GetResult(pop, sum_id).AsDouble() == count_ones());
+  CHECK(num_calls == 4);
+
+  // Writing a trait in place, with no signal or module call, must produce a fresh result.
+  emp::BitVector & bits = pop[0].GetTrait<emp::BitVector>("bits");
+  bits = emp::BitVector(50, true);
+  CHECK(planner.GetResult(pop, sum_id).AsDouble() == count_ones());
+  CHECK(num_calls == 8);
+
+  // The same holds for SetTrait().
+  pop[1].SetTrait<emp::BitVector>("bits", emp::BitVector(20, true));
+  CHECK(planner.GetResult(pop, sum_id).AsDouble() == count_ones());
+  CHECK(num_calls == 12);
+}
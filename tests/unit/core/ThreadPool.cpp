@@ -0,0 +1,72 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  ThreadPool.cpp
+ *  @brief Tests for the shared worker thread pool.
+ */
+
+#include <atomic>
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// Empirical
+#include "emp/base/vector.hpp"
+// MABE
+#include "core/ThreadPool.hpp"
+
+
+TEST_CASE("ThreadPool_Basic", "[core]"){
+  mabe::ThreadPool pool;
+  CHECK(pool.GetNumThreads() == 1);
+
+  // A single-threaded pool runs every job on the calling thread.
+  size_t run_count = 0;
+  size_t last_thread_id = 100;
+  pool.RunOnAll([&](size_t thread_id){ last_thread_id = thread_id; ++run_count; });
+  CHECK(run_count == 1);
+  CHECK(last_thread_id == 0);
+
+  // A multi-threaded pool runs each job once per thread.  (Catch2 checks are not thread safe,
+  // so record what each thread saw and check it after the job is done.)
+  pool.SetNumThreads(4);
+  CHECK(pool.GetNumThreads() == 4);
+  std::atomic<size_t> thread_count{0};
+  std::atomic<size_t> bad_ids{0};
+  emp::vector<size_t> runs_per_thread(4, 0);
+  pool.RunOnAll([&](size_t thread_id){
+    if (thread_id < 4) runs_per_thread[thread_id]++;
+    else ++bad_ids;
+    ++thread_count;
+  });
+  CHECK(thread_count == 4);
+  CHECK(bad_ids == 0);
+  CHECK(runs_per_thread == emp::vector<size_t>({1, 1, 1, 1}));
+
+  // Shrinking the pool should stop extra workers.
+  pool.SetNumThreads(2);
+  CHECK(pool.GetNumThreads() == 2);
+}
+
+TEST_CASE("ThreadPool_ForEachChunk", "[core]"){
+  mabe::ThreadPool pool(4);
+
+  // Every item must be processed exactly once, in the expected chunk.
+  emp::vector<size_t> visits(1000, 0);
+  emp::vector<size_t> chunk_ids(1000, 0);
+  pool.ForEachChunk(visits.size(), 64,
+    [&](size_t start, size_t end, size_t chunk_id, size_t /*thread_id*/){
+      for (size_t i = start; i < end; ++i) { visits[i]++; chunk_ids[i] = chunk_id; }
+    });
+  for (size_t i = 0; i < visits.size(); ++i) {
+    CHECK(visits[i] == 1);
+    CHECK(chunk_ids[i] == i / 64);
+  }
+
+  // Empty ranges should not call the function at all.
+  bool called = false;
+  pool.ForEachChunk(0, 64, [&](size_t, size_t, size_t, size_t){ called = true; });
+  CHECK(called == false);
+}
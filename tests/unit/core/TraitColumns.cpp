@@ -0,0 +1,109 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  TraitColumns.cpp
+ *  @brief Tests for contiguous per-population trait mirrors.
+ */
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// Empirical
+#include "emp/data/DataMap.hpp"
+// MABE
+#include "core/TraitColumns.hpp"
+
+// Minimal organism stand-in: TraitColumns only needs IsEmpty() and GetTrait<T>(id).
+struct TestOrg {
+  emp::DataMap dm;
+  bool empty = false;
+
+  TestOrg(const emp::DataMap & in_dm, bool in_empty=false) : dm(in_dm), empty(in_empty) { }
+  bool IsEmpty() const { return empty; }
+  template <typename T> T & GetTrait(size_t id) { return dm.Get<T>(id); }
+  template <typename T> const T & GetTrait(size_t id) const { return dm.Get<T>(id); }
+};
+
+TEST_CASE("TraitColumns_Basic", "[core]"){
+  emp::DataMap base_dm;
+  const size_t fit_id = base_dm.AddVar<double>("fitness", 1.5);
+  const size_t count_id = base_dm.AddVar<int>("count", 3);
+  base_dm.AddVar<std::string>("name", "org");
+  base_dm.LockLayout();
+
+  mabe::TraitColumns columns;
+  CHECK(columns.AddColumn(base_dm.GetLayout(), "fitness") == true);
+  CHECK(columns.AddColumn(base_dm.GetLayout(), "count") == true);
+  CHECK(columns.AddColumn(base_dm.GetLayout(), "name") == false);     // Not numeric.
+  CHECK(columns.AddColumn(base_dm.GetLayout(), "missing") == false);  // No such trait.
+  CHECK(columns.GetNumColumns() == 2);
+  CHECK(columns.HasColumn(fit_id));
+
+  emp::vector<emp::Ptr<TestOrg>> orgs;
+  for (size_t i = 0; i < 5; ++i) orgs.push_back(emp::NewPtr<TestOrg>(base_dm, i == 2));
+  for (size_t i = 0; i < 5; ++i) orgs[i]->GetTrait<double>(fit_id) = (double) i;
+
+  columns.Rebuild(orgs);
+  auto fitness = columns.GetValues(fit_id);
+  REQUIRE(fitness.size() == 5);
+  CHECK(fitness[0] == 0.0);
+  CHECK(fitness[4] == 4.0);
+  CHECK(columns.GetValues(count_id)[1] == 3.0);
+
+  // The view covers every position in order, including empty cells (like Collection(pop)).
+  mabe::TraitColumns::View view = columns.GetView(fit_id);
+  CHECK(view.size() == 5);
+  CHECK(view.At(2) == 2.0);
+  CHECK(view.At(3) == 3.0);
+  double total = 0.0;
+  for (double val : view) total += val;
+  CHECK(total == 10.0);
+
+  // Only the listed positions are re-read by an update.
+  orgs[0]->GetTrait<double>(fit_id) = 10.0;
+  orgs[4]->GetTrait<double>(fit_id) = 40.0;
+  const emp::vector<size_t> dirty{0};
+  columns.Update(orgs, dirty);
+  CHECK(columns.GetValues(fit_id)[0] == 10.0);
+  CHECK(columns.GetValues(fit_id)[4] == 4.0);
+  columns.Rebuild(orgs);
+  CHECK(columns.GetValues(fit_id)[4] == 40.0);
+
+  for (auto org_ptr : orgs) org_ptr.Delete();
+}
+
+TEST_CASE("TraitColumns_EmptyCells", "[core]"){
+  emp::DataMap base_dm;
+  const size_t fit_id = base_dm.AddVar<double>("fitness", 0.0);
+  base_dm.LockLayout();
+
+  // An empty cell holds the empty organism's values, and is re-read when it is filled.
+  TestOrg empty_org(base_dm, true);
+  empty_org.GetTrait<double>(fit_id) = -1.0;
+  emp::vector<emp::Ptr<TestOrg>> orgs(4, &empty_org);
+  orgs[1] = emp::NewPtr<TestOrg>(base_dm);
+  orgs[1]->GetTrait<double>(fit_id) = 5.0;
+
+  mabe::TraitColumns columns;
+  REQUIRE(columns.AddColumn(base_dm.GetLayout(), "fitness"));
+  columns.Rebuild(orgs);
+  CHECK(columns.GetView(fit_id).size() == 4);
+  CHECK(columns.GetValues(fit_id)[0] == -1.0);
+  CHECK(columns.GetValues(fit_id)[1] == 5.0);
+  CHECK(columns.GetValues(fit_id)[3] == -1.0);
+
+  orgs[3] = emp::NewPtr<TestOrg>(base_dm);
+  orgs[3]->GetTrait<double>(fit_id) = 7.0;
+  const emp::vector<size_t> dirty{3};
+  columns.Update(orgs, dirty);
+  CHECK(columns.GetValues(fit_id)[3] == 7.0);
+
+  orgs[1].Delete();
+  orgs[1] = &empty_org;
+  const emp::vector<size_t> dirty2{1};
+  columns.Update(orgs, dirty2);
+  CHECK(columns.GetValues(fit_id)[1] == -1.0);
+  orgs[3].Delete();
+}
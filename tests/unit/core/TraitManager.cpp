@@ -635,3 +635,88 @@ TEST_CASE("TraitManager_Verify", "[core]") {
 }
 
 
+
+// A module that only reaches its traits through OrgTraits, so they may be stored compactly.
+struct CompactTestModule : public mabe::Module {
+  mabe::OwnedTrait<bool> flag_a_trait{this, "flag_a", "a trait"};
+  mabe::OwnedTrait<bool> flag_b_trait{this, "flag_b", "a trait"};
+  mabe::OwnedTrait<double> score_trait{this, "score", "a trait"};
+  mabe::OwnedTrait<double> exact_trait{this, "exact", "a trait"};
+
+  CompactTestModule(mabe::MABE & control) : Module(control, "CompactTest") { }
+};
+
+TEST_CASE("TraitManager_CompactStorage", "[core]"){
+  {
+    //  [SETUP]
+    mabe::MABE control(0, NULL);
+    control.AddPopulation("test_pop");
+    CompactTestModule test_mod(control);
+    mabe::EvalNK nk_mod(control);
+    mabe::TraitManager<mabe::ModuleBase> trait_man;
+    trait_man.Unlock();
+    constexpr auto OWNED = mabe::TraitInfo::Access::OWNED;
+    trait_man.AddTrait<bool>(&test_mod, OWNED, "flag_a", "a trait", true, 1);
+    trait_man.AddTrait<bool>(&test_mod, OWNED, "flag_b", "a trait", false, 1);
+    trait_man.AddTrait<double>(&test_mod, OWNED, "score", "a trait", 2.5, 1);
+    trait_man.AddTrait<double>(&test_mod, OWNED, "exact", "a trait", 1.0, 1);
+    // EvalNK accesses its traits by name, so they cannot be stored compactly.
+    trait_man.AddTrait<double>(&nk_mod, OWNED, "by_name", "a trait", 1.0, 1);
+    trait_man.AddTrait<bool>(&nk_mod, OWNED, "by_name_flag", "a trait", false, 1);
+    CHECK(trait_man.SetCompact("flag_a"));
+    CHECK(trait_man.SetCompact("flag_b"));
+    CHECK(trait_man.SetCompact("score"));
+    CHECK(trait_man.SetCompact("by_name"));
+    CHECK(trait_man.SetCompact("by_name_flag"));
+    CHECK_FALSE(trait_man.SetCompact("no_such_trait"));
+    emp::Ptr<mabe::TraitInfo> score = trait_man.GetTraitInfo("score");
+
+    size_t error_count = 0;
+    emp::notify::GetData().GetHandler(emp::notify::Type::ERROR).Clear();
+    emp::notify::GetData().GetHandler(emp::notify::Type::ERROR).Add(
+        [&error_count](emp::notify::id_arg_t, emp::notify::message_arg_t,
+                       emp::notify::except_data_t){
+          error_count++;
+          return true;
+        }
+    );
+
+    //  [BEGIN TESTS]
+    // Compact bools share a single byte; compact doubles become floats.
+    emp::DataMap dm;
+    trait_man.RegisterAll(dm);
+    dm.LockLayout();
+    trait_man.BuildResetImage(dm);
+    CHECK_FALSE(dm.HasName("flag_a"));
+    CHECK(dm.IsType<uint8_t>("_packed_bits_0"));
+    CHECK(dm.Get<uint8_t>("_packed_bits_0") == 1);  // flag_a defaults to true.
+    CHECK(dm.IsType<float>("score"));
+    CHECK(dm.IsType<double>("exact"));
+
+    // Converted traits keep their info object (modules hold references to it) and type.
+    CHECK(trait_man.GetTraitInfo("score") == score);
+    CHECK(score->IsType<double>());
+    CHECK(score->GetStorage() == mabe::TraitInfo::Storage::FLOAT32);
+    CHECK(score->GetStorageSize() == sizeof(float));
+
+    // Traits accessed by name keep their normal storage, with an error for each.
+    CHECK(error_count == 2);
+    CHECK(dm.IsType<double>("by_name"));
+    CHECK(dm.IsType<bool>("by_name_flag"));
+    CHECK(trait_man.GetTraitInfo("by_name")->GetStorage() == mabe::TraitInfo::Storage::NATIVE);
+
+    emp::Ptr<mabe::TraitInfo> flag_b = trait_man.GetTraitInfo("flag_b");
+    CHECK(flag_b->GetStorage() == mabe::TraitInfo::Storage::PACKED_BIT);
+    mabe::TraitLocation loc;
+    CHECK(loc.Locate(dm, "flag_b", flag_b));
+    CHECK(loc.IsCompatible<bool>(dm));
+    CHECK(loc.mask == 2);
+
+    // Resetting restores both the packed bits and the float values.
+    dm.Get<uint8_t>("_packed_bits_0") = 2;
+    dm.Get<float>("score") = 7.0f;
+    trait_man.ResetAll(dm);
+    CHECK(dm.Get<uint8_t>("_packed_bits_0") == 1);
+    CHECK(dm.Get<float>("score") == 2.5f);
+  }
+}
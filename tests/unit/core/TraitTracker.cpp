@@ -0,0 +1,135 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  TraitTracker.cpp
+ *  @brief Tests for incrementally updated trait statistics.
+ */
+
+#include <cmath>
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// Empirical
+#include "emp/data/DataMap.hpp"
+// MABE
+#include "core/TraitTracker.hpp"
+
+// Minimal organism stand-in: TraitTracker only needs IsEmpty(), GetContentHash(id), and
+// GetTrait<T>(id).
+struct TestOrg {
+  emp::DataMap dm;
+  bool empty = false;
+
+  TestOrg(const emp::DataMap & in_dm, bool in_empty=false) : dm(in_dm), empty(in_empty) { }
+  bool IsEmpty() const { return empty; }
+  template <typename T> T & GetTrait(size_t id) { return dm.Get<T>(id); }
+  template <typename T> const T & GetTrait(size_t id) const { return dm.Get<T>(id); }
+  uint64_t GetContentHash(size_t id) const { return mabe::ContentHash(dm.Get<std::string>(id)); }
+};
+
+TEST_CASE("TraitTracker_Basic", "[core]"){
+  emp::DataMap base_dm;
+  const size_t fit_id = base_dm.AddVar<double>("fitness", 1.0);
+  const size_t gen_id = base_dm.AddVar<int>("generation", 0);
+  base_dm.AddVar<std::string>("name", "org");
+  base_dm.LockLayout();
+
+  mabe::TraitTracker tracker;
+  CHECK(tracker.IsActive() == false);
+  CHECK(tracker.AddTrait(base_dm.GetLayout(), "fitness") == true);
+  CHECK(tracker.AddTrait(base_dm.GetLayout(), "generation") == true);
+  CHECK(tracker.AddTrait(base_dm.GetLayout(), "missing") == false);  // No such trait.
+  CHECK(tracker.GetNumTraits() == 2);
+  CHECK(tracker.HasTrait(gen_id));
+
+  emp::vector<emp::Ptr<TestOrg>> orgs;
+  for (size_t i = 0; i < 10; ++i) orgs.push_back(emp::NewPtr<TestOrg>(base_dm, i == 9));
+  for (size_t i = 0; i < 9; ++i) orgs[i]->GetTrait<double>(fit_id) = (double) i;
+
+  // Position 9 is empty, but (like Collection(pop)) still counts, with the default value.
+  tracker.Update(orgs);
+  CHECK(tracker.GetCount(fit_id) == 10);
+  CHECK(tracker.GetSum(fit_id) == 37.0);
+  CHECK(tracker.GetMean(fit_id) == Approx(3.7));
+  CHECK(tracker.GetVariance(fit_id) == Approx(7.5666666667)); // Sample variance of 0..8, 1
+  CHECK(tracker.GetMin(fit_id) == 0.0);
+  CHECK(tracker.GetMax(fit_id) == 8.0);
+  CHECK(tracker.GetSum(gen_id) == 0.0);
+
+  // Changes are only seen at dirty positions.
+  orgs[8]->GetTrait<double>(fit_id) = 2.0;
+  orgs[0]->GetTrait<double>(fit_id) = 20.0;
+  tracker.MarkDirty(8);
+  tracker.Update(orgs);
+  CHECK(tracker.GetMax(fit_id) == 7.0);    // Stale max (8 at position 8) is discarded.
+  CHECK(tracker.GetMin(fit_id) == 0.0);    // Position 0 was not marked.
+  tracker.MarkDirty(0);
+  tracker.MarkDirty(0);
+  tracker.Update(orgs);
+  CHECK(tracker.GetMin(fit_id) == 1.0);
+  CHECK(tracker.GetMax(fit_id) == 20.0);
+  CHECK(tracker.GetSum(fit_id) == 51.0);
+
+  // Removing an organism (its cell takes the default values) and placing another.
+  orgs[3]->empty = true;
+  orgs[3]->GetTrait<double>(fit_id) = 1.0;
+  orgs[9]->empty = false;
+  orgs[9]->GetTrait<int>(gen_id) = 5;
+  tracker.MarkDirty(3);
+  tracker.MarkDirty(9);
+  tracker.Update(orgs);
+  CHECK(tracker.GetCount(fit_id) == 10);
+  CHECK(tracker.GetSum(fit_id) == 49.0);
+  CHECK(tracker.GetMax(gen_id) == 5.0);
+  CHECK(tracker.GetStat(gen_id, mabe::TraitTracker::Stat::MEAN) == Approx(0.5));
+  CHECK(mabe::TraitTracker::ToStat("ave") == mabe::TraitTracker::Stat::MEAN);
+  CHECK(mabe::TraitTracker::ToStat("median") == mabe::TraitTracker::Stat::NONE);
+
+  for (auto org_ptr : orgs) org_ptr.Delete();
+}
+
+TEST_CASE("TraitTracker_Hashed", "[core]"){
+  using Stat = mabe::TraitTracker::Stat;
+  emp::DataMap base_dm;
+  base_dm.AddVar<double>("fitness", 1.0);
+  const size_t genome_id = base_dm.AddVar<std::string>("genome", "aaa");
+  base_dm.AddVar<emp::vector<int>>("values", emp::vector<int>{});
+  base_dm.LockLayout();
+
+  mabe::TraitTracker tracker;
+  CHECK(tracker.AddTrait(base_dm.GetLayout(), "genome") == true);
+  CHECK(tracker.AddTrait(base_dm.GetLayout(), "values") == false);   // Not numeric or string.
+  CHECK(tracker.IsHashed(genome_id));
+  CHECK(tracker.HasStat(genome_id, Stat::RICHNESS));
+  CHECK(tracker.HasStat(genome_id, Stat::MEAN) == false);
+
+  emp::vector<emp::Ptr<TestOrg>> orgs;
+  for (size_t i = 0; i < 6; ++i) orgs.push_back(emp::NewPtr<TestOrg>(base_dm, i == 5));
+  orgs[1]->GetTrait<std::string>(genome_id) = "bbb";
+  orgs[2]->GetTrait<std::string>(genome_id) = "bbb";
+  orgs[3]->GetTrait<std::string>(genome_id) = "bbb";
+  orgs[4]->GetTrait<std::string>(genome_id) = "bbb";
+  // Position 5 is empty, but is counted with its default value (as in Collection(pop)).
+
+  tracker.Update(orgs);
+  CHECK(tracker.GetCount(genome_id) == 6);
+  CHECK(tracker.GetRichness(genome_id) == 2);
+  CHECK(orgs[tracker.GetModePos(genome_id)]->GetTrait<std::string>(genome_id) == "bbb");
+  CHECK(tracker.GetEntropy(genome_id) ==
+        Approx(-(2.0/6.0)*std::log2(2.0/6.0) - (4.0/6.0)*std::log2(4.0/6.0)));
+
+  // Replace the recorded example of the mode; another must be found.
+  const size_t mode_pos = tracker.GetModePos(genome_id);
+  orgs[mode_pos]->GetTrait<std::string>(genome_id) = "ccc";
+  tracker.MarkDirty(mode_pos);
+  tracker.Update(orgs);
+  CHECK(tracker.GetStat(genome_id, Stat::RICHNESS) == 3.0);
+  const size_t new_pos = tracker.GetModePos(genome_id);
+  CHECK(new_pos != mode_pos);
+  CHECK(orgs[new_pos]->GetTrait<std::string>(genome_id) == "bbb");
+
+  for (auto org_ptr : orgs) org_ptr.Delete();
+}
@@ -43,6 +43,102 @@ T& GetConfiguredRef(
   return *dynamic_cast<T*>(symbol_obj.GetObjectPtr().Raw());
 }
 
+// The sites that mutating one site at a time (as the original Mutate_Generic did) would hit,
+// in the coordinates of MutationSites: points redraw sites already hit, then insertions and
+// deletions are made one by one at random positions of the changing genome.
+void ChooseMutationsOneAtATime(mabe::VirtualCPUOrg & org, size_t old_size,
+                                emp::Random & random,
+                                mabe::VirtualCPUOrg::MutationSites & sites){
+  sites.point_sites.resize(0);
+  const size_t num_points = org.SharedData().point_mut_dist.PickRandom(old_size, random);
+  emp::BitVector hit(old_size);
+  for (size_t i = 0; i < num_points; i++) {
+    const size_t pos = random.GetUInt(old_size);
+    if (hit[pos]) { --i; continue; }
+    hit[pos] = true;
+    sites.point_sites.push_back(pos);
+  }
+  std::sort(sites.point_sites.begin(), sites.point_sites.end());
+
+  emp::vector<bool> is_inserted(old_size, false);
+  const size_t num_inserts = org.SharedData().insertion_mut_dist.PickRandom(old_size, random);
+  for (size_t i = 0; i < num_inserts; i++) {
+    is_inserted.insert(is_inserted.begin() + random.GetUInt(is_inserted.size()), true);
+  }
+  sites.insert_sites.resize(0);
+  for (size_t pos = 0; pos < is_inserted.size(); pos++) {
+    if (is_inserted[pos]) sites.insert_sites.push_back(pos);
+  }
+
+  emp::vector<size_t> remaining(is_inserted.size());
+  for (size_t pos = 0; pos < remaining.size(); pos++) remaining[pos] = pos;
+  const size_t num_deletes =
+    org.SharedData().deletion_mut_dist.PickRandom(remaining.size(), random);
+  sites.delete_sites.resize(0);
+  for (size_t i = 0; i < num_deletes && remaining.size(); i++) {
+    const size_t pos = random.GetUInt(remaining.size());
+    sites.delete_sites.push_back(remaining[pos]);
+    remaining.erase(remaining.begin() + pos);
+  }
+  std::sort(sites.delete_sites.begin(), sites.delete_sites.end());
+}
+
+TEST_CASE("VirtualCPUOrg_MutationDistribution", "[orgs]"){
+  // Batched mutations must hit the same numbers and sites as mutating one site at a time.
+  mabe::MABE control(0, nullptr);
+  control.GetRandom().ResetSeed(110);
+  mabe::OrganismManager<mabe::VirtualCPUOrg> manager(control, "name", "desc");
+  mabe::VirtualCPUOrg org(manager);
+  org.SharedData().point_mut_prob = 0.1;
+  org.SharedData().insertion_mut_prob = 0.05;
+  org.SharedData().deletion_mut_prob = 0.05;
+  org.SharedData().init_length = 20;
+  org.SetupMutationDistribution();
+
+  constexpr size_t GENOME_SIZE = 20;
+  constexpr size_t NUM_TRIALS = 20000;
+  constexpr size_t MAX_COUNT = 64;
+  using hist_t = emp::vector<emp::vector<double>>;  // [kind][count or site]
+  hist_t batched_counts(3, emp::vector<double>(MAX_COUNT, 0.0));
+  hist_t batched_sites = batched_counts;
+  hist_t single_counts = batched_counts;
+  hist_t single_sites = batched_counts;
+  auto tally = [](const mabe::VirtualCPUOrg::MutationSites & sites,
+                  hist_t & counts, hist_t & site_hits) {
+    const emp::vector<size_t> * kinds[3] =
+      { &sites.point_sites, &sites.insert_sites, &sites.delete_sites };
+    for (size_t kind = 0; kind < 3; kind++) {
+      counts[kind][std::min(kinds[kind]->size(), MAX_COUNT - 1)] += 1.0 / NUM_TRIALS;
+      for (size_t pos : *kinds[kind]) site_hits[kind][pos] += 1.0 / NUM_TRIALS;
+    }
+  };
+
+  mabe::VirtualCPUOrg::MutationSites sites;
+  for (size_t trial = 0; trial < NUM_TRIALS; trial++) {
+    org.ChooseMutations(GENOME_SIZE, control.GetRandom(), sites);
+    // Sites of each kind are distinct and in increasing order.
+    for (const emp::vector<size_t> * kind_sites :
+           { &sites.point_sites, &sites.insert_sites, &sites.delete_sites }) {
+      CHECK(std::adjacent_find(kind_sites->begin(), kind_sites->end(),
+                               std::greater_equal<size_t>()) == kind_sites->end());
+    }
+    tally(sites, batched_counts, batched_sites);
+    ChooseMutationsOneAtATime(org, GENOME_SIZE, control.GetRandom(), sites);
+    tally(sites, single_counts, single_sites);
+  }
+
+  // Frequencies are around 0.05 to 0.3, with a standard error of the difference near 0.003.
+  for (size_t kind = 0; kind < 3; kind++) {
+    for (size_t i = 0; i < MAX_COUNT; i++) {
+      CHECK(batched_counts[kind][i] == Approx(single_counts[kind][i]).margin(0.015));
+      CHECK(batched_sites[kind][i] == Approx(single_sites[kind][i]).margin(0.015));
+    }
+  }
+  // Point mutations stay within the original genome, hitting each site at the per-site rate.
+  CHECK(batched_sites[0][GENOME_SIZE] == 0.0);
+  CHECK(batched_sites[0][GENOME_SIZE / 2] == Approx(0.1).margin(0.015));
+}
+
 TEST_CASE("VirtualCPUOrg_Main", "[orgs]"){
   // Initialize the instruction library, which only needs done once
   mabe::MABE control(0, nullptr);
@@ -194,6 +290,20 @@ TEST_CASE("VirtualCPUOrg_Main", "[orgs]"){
       }
     }
     CHECK(realized_num_muts == 100);
+
+    // Genome hash and trait stay current through point mutations, insertions, and deletions
+    CHECK(org.GetGenomeHash() == org.CalcGenomeHash());
+    manager.AsScope().GetSymbol("point_mut_prob")->SetValue(0.02);
+    manager.AsScope().GetSymbol("insertion_mut_prob")->SetValue(0.02);
+    manager.AsScope().GetSymbol("deletion_mut_prob")->SetValue(0.02);
+    org.SetupMutationDistribution();
+    for(size_t i = 0; i < 20; ++i){
+      org.Mutate(control.GetRandom());
+      CHECK(org.GetGenomeHash() == org.CalcGenomeHash());
+    }
+    // The genome trait is rendered when first read, then cached in the trait
+    CHECK(org.GetGenomeText() == org.GetGenomeString());
+    CHECK(org.GetTrait<std::string>("genome") == org.GetGenomeString());
   }
   {// Randomize
     control.GetRandom().ResetSeed(102);
@@ -239,7 +349,7 @@ TEST_CASE("VirtualCPUOrg_Main", "[orgs]"){
     org.SharedData().initial_merit = 20;;
     org.Initialize(control.GetRandom());
     CHECK(org.GetGenomeSize() == 50);
-    CHECK(org.GetTrait<std::string>("genome") == org.GetGenomeString());
+    CHECK(org.GetGenomeText() == org.GetGenomeString());
     CHECK(org.GetTrait<double>("merit") == 1.0);
     CHECK(org.GetTrait<double>("child_merit") == 20);
     CHECK(org.nops_need_curated == false);
@@ -252,7 +362,7 @@ TEST_CASE("VirtualCPUOrg_Main", "[orgs]"){
     org_2.SharedData().initial_genome_filename = "org_nops.org";
     org_2.Initialize(control.GetRandom());
     CHECK(org_2.GetGenomeSize() == 50);
-    CHECK(org_2.GetTrait<std::string>("genome") == "[50]abcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcab");
+    CHECK(org_2.GetGenomeText() == "[50]abcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcab");
     CHECK(org_2.GetTrait<double>("merit") == 1.0); 
     CHECK(org_2.GetTrait<double>("child_merit") == 20);
     CHECK(org_2.nops_need_curated == false);
@@ -308,9 +418,16 @@ TEST_CASE("VirtualCPUOrg_Main", "[orgs]"){
     org.SetTrait<double>("child_merit", 3);
     std::string original_genome = org.GetGenomeString();
     org.AdvanceIP(1);
-    org.SetTrait<mabe::VirtualCPUOrg::genome_t>("offspring_genome", org.genome);
+    org.SetTrait<mabe::VirtualCPUOrg::GenomeBuffer>("offspring_genome",
+        mabe::VirtualCPUOrg::GenomeBuffer(org.genome));
     emp::Ptr<mabe::VirtualCPUOrg> child_org_1 = 
         org.MakeOffspringOrganism(control.GetRandom()).DynamicCast<mabe::VirtualCPUOrg>();
+    // The unmutated child shares the genome its parent copied, but not the offspring trait
+    const mabe::VirtualCPUOrg::GenomeBuffer & parent_buffer =
+        org.GetTrait<mabe::VirtualCPUOrg::GenomeBuffer>("offspring_genome");
+    CHECK(&child_org_1->ReadGenome() == &parent_buffer.Get());
+    CHECK(parent_buffer.GetNumShares() == 2);
+    CHECK(child_org_1->GetTrait<mabe::VirtualCPUOrg::GenomeBuffer>("offspring_genome").IsEmpty());
     std::string child_genome_1 =
         child_org_1->GetGenomeString();
     std::cout << "Parent: " << original_genome << std::endl;
@@ -337,6 +454,59 @@ TEST_CASE("VirtualCPUOrg_Main", "[orgs]"){
     CHECK(child_org_2->inst_ptr == 0); 
     child_org_2.Delete();
   }
+  { // Shared genomes
+    // [X] Clones share their parent's genome until they run or change
+    // [X] Running a clone gives it its own copy first; others keep sharing
+    // [X] Mutating a clone copies the genome first and leaves the others unchanged
+    control.GetRandom().ResetSeed(105);
+    mabe::OrganismManager<mabe::VirtualCPUOrg> manager(control, "name", "desc");
+    mabe::VirtualCPUOrg org(manager);
+    org.SharedData().init_random = true;
+    org.SharedData().init_length = 50;
+    org.SharedData().point_mut_prob = 0;
+    org.SetupMutationDistribution();
+    emp::DataMap data_map = control.GetOrganismDataMap();
+    control.GetTraitManager().RegisterAll(data_map);
+    data_map.LockLayout();          
+    org.SetDataMap(data_map);
+    org.Initialize(control.GetRandom());
+    const std::string original_genome = org.GetGenomeString();
+    emp::Ptr<mabe::VirtualCPUOrg> clone_1 = org.CloneOrganism().DynamicCast<mabe::VirtualCPUOrg>();
+    emp::Ptr<mabe::VirtualCPUOrg> clone_2 = org.CloneOrganism().DynamicCast<mabe::VirtualCPUOrg>();
+    CHECK(clone_1->genome.size() == 0);
+    CHECK(clone_2->genome.size() == 0);
+    CHECK(&clone_1->ReadGenome() == &clone_2->ReadGenome());
+    CHECK(clone_1->GetGenomeSize() == 50);
+    CHECK(clone_1->GetGenomeHash() == org.GetGenomeHash());
+    CHECK(clone_1->GetTrait<size_t>("genome_length") == 50);
+    // Running builds the clone's own genome and hardware; the other clone keeps sharing
+    clone_1->ProcessStep();
+    CHECK(clone_1->genome.size() == 50);
+    CHECK(clone_1->inst_ptr == 1);
+    CHECK(&clone_1->ReadGenome() != &clone_2->ReadGenome());
+    CHECK(clone_2->genome.size() == 0);
+    CHECK(clone_1->GetGenomeString() == original_genome);
+    // Writing copies the genome first
+    org.SharedData().point_mut_prob = 1;
+    org.SetupMutationDistribution();
+    CHECK(clone_2->Mutate(control.GetRandom()) == 50);
+    CHECK(clone_2->genome.size() == 50);
+    CHECK(clone_2->GetGenomeHash() == clone_2->CalcGenomeHash());
+    CHECK(clone_2->GetGenomeString() != original_genome);
+    CHECK(clone_1->GetGenomeString() == original_genome);
+    CHECK(org.GetGenomeString() == original_genome);
+    // Later clones still share the parent's (unchanged) genome
+    emp::Ptr<mabe::VirtualCPUOrg> clone_3 = org.CloneOrganism().DynamicCast<mabe::VirtualCPUOrg>();
+    CHECK(clone_3->genome.size() == 0);
+    CHECK(clone_3->GetGenomeString() == original_genome);
+    CHECK(clone_3->GetGenomeText() == original_genome);
+    CHECK(clone_3->genome.size() == 0);   // Rendering the genome does not build it
+    org.SharedData().point_mut_prob = 0;
+    org.SetupMutationDistribution();
+    clone_1.Delete();
+    clone_2.Delete();
+    clone_3.Delete();
+  }
   { // ProcessStep 
     control.GetRandom().ResetSeed(106);
     mabe::OrganismManager<mabe::VirtualCPUOrg> manager(control, "name", "desc");
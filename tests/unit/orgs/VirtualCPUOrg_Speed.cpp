@@ -0,0 +1,108 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  VirtualCPUOrg_Speed.cpp
+ *  @brief Time a VirtualCPUOrg running a fixed number of instructions.
+ *
+ *  Reports instructions per second, both for the organism as a whole and for calling one
+ *  instruction's handlers through resolved dispatch (Action::BuildDispatch) versus checked
+ *  AnyFunction calls (how every instruction used to be called).  Timings are only printed;
+ *  they depend too much on the machine and build flags to be checked.
+ */
+
+#include <chrono>
+#include <iostream>
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// MABE
+#include "orgs/VirtualCPUOrg.hpp"
+#include "orgs/instructions/VirtualCPU_Inst_Nop.hpp"
+#include "orgs/instructions/VirtualCPU_Inst_IO.hpp"
+
+template<typename T>
+T& GetConfiguredRef(
+    mabe::MABE& control,
+    const std::string& type_name,
+    const std::string& var_name,
+    emplode::Symbol_Scope& scope){
+  emplode::Symbol_Object& symbol_obj =
+      control.GetConfigScript().GetSymbolTable().MakeObjSymbol(type_name, var_name, scope);
+  return *dynamic_cast<T*>(symbol_obj.GetObjectPtr().Raw());
+}
+
+/// Run fun (which executes num_insts instructions) and print how many ran per second.
+template <typename FUN_T>
+double ReportSpeed(const std::string & label, size_t num_insts, FUN_T fun){
+  const auto start = std::chrono::steady_clock::now();
+  fun();
+  const std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+  const double ips = (double) num_insts / secs.count();
+  std::cout << label << ": " << num_insts << " instructions in " << secs.count()
+            << " s (" << ips << " instructions per second)" << std::endl;
+  return ips;
+}
+
+TEST_CASE("VirtualCPUOrg_Speed", "[orgs]"){
+  constexpr size_t NUM_INSTS = 1000000;
+
+  mabe::MABE control(0, nullptr);
+  control.GetRandom().ResetSeed(100);
+  control.AddPopulation("test_pop", 0);
+  mabe::OrganismManager<mabe::VirtualCPUOrg> manager(control, "name", "desc");
+  emplode::Symbol_Scope root_scope("root_scope", "desc", nullptr);
+  mabe::VirtualCPU_Inst_Nop& nop_inst_module =
+      GetConfiguredRef<mabe::VirtualCPU_Inst_Nop>(
+        control, "VirtualCPU_Inst_Nop", "insts_nop", root_scope);
+  mabe::VirtualCPU_Inst_IO& io_inst_module =
+      GetConfiguredRef<mabe::VirtualCPU_Inst_IO>(
+          control, "VirtualCPU_Inst_IO", "insts_io", root_scope);
+  mabe::VirtualCPUOrg tmp_org(manager);
+  tmp_org.SharedData().inst_set_input_filename = "inst_set_test.txt";
+  control.GetTraitManager().Unlock();
+  nop_inst_module.SetupModule();
+  io_inst_module.SetupModule();
+  tmp_org.SetupModule();
+  control.GetTraitManager().Lock();
+  emp::DataMap data_map = control.GetOrganismDataMap();
+  control.GetTraitManager().RegisterAll(data_map);
+  data_map.LockLayout();
+
+  // A genome of nops, which the CPU loops over.
+  mabe::VirtualCPUOrg org(manager);
+  org.SharedData().point_mut_prob = 0;
+  org.SharedData().init_random = false;
+  org.SharedData().initial_genome_filename = "org_nops.org";
+  org.SetupMutationDistribution();
+  org.SetDataMap(data_map);
+  org.Initialize(control.GetRandom());
+
+  { // The whole organism, as run by the schedulers.
+    size_t num_run = 0;
+    const double ips = ReportSpeed("VirtualCPUOrg::ProcessSteps", NUM_INSTS,
+                                   [&org, &num_run](){ num_run = org.ProcessSteps(NUM_INSTS); });
+    CHECK(num_run == NUM_INSTS);
+    CHECK(ips > 0.0);
+  }
+
+  { // One instruction's handlers, resolved at setup versus type-checked on every call.
+    using inst_t = mabe::VirtualCPUOrg::inst_t;
+    mabe::Action & action = control.GetActionMap(0)
+      .GetFuncs<void, mabe::VirtualCPUOrg&, const inst_t&>().at("NopA");
+    const inst_t & inst = org.genome_working[0];
+    const auto dispatch = action.BuildDispatch<mabe::VirtualCPUOrg&, const inst_t&>();
+    ReportSpeed("NopA via resolved dispatch", NUM_INSTS, [&](){
+      for (size_t i = 0; i < NUM_INSTS; ++i) dispatch(org, inst);
+    });
+    ReportSpeed("NopA via checked AnyFunction calls", NUM_INSTS, [&](){
+      for (size_t i = 0; i < NUM_INSTS; ++i) {
+        for (size_t func_idx = 0; func_idx < action.function_vec.size(); ++func_idx) {
+          action.function_vec[func_idx].Call<void, mabe::VirtualCPUOrg&, const inst_t&>(org, inst);
+        }
+      }
+    });
+  }
+}
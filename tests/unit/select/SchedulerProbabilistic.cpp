@@ -0,0 +1,108 @@
+/**
+ *  @note This file is part of MABE, https://github.com/mercere99/MABE2
+ *  @copyright Copyright (C) Michigan State University, MIT Software license; see doc/LICENSE.md
+ *  @date 2022.
+ *
+ *  @file  SchedulerProbabilistic.cpp
+ *  @brief Tests for SchedulerProbabilistic, including timing time_slice against per_step mode.
+ */
+
+#include <chrono>
+#include <iostream>
+
+// CATCH
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+// MABE
+#include "core/MABE.hpp"
+#include "core/OrganismManager.hpp"
+#include "select/SchedulerProbabilistic.hpp"
+
+// An organism that only counts its steps; every slice_every steps it ends its time slice, as
+// an organism does when it reproduces (but it stays in place).
+class StepOrg : public mabe::OrganismTemplate<StepOrg> {
+public:
+  size_t steps = 0;
+
+  StepOrg(mabe::OrganismManager<StepOrg> & _manager) : OrganismTemplate<StepOrg>(_manager) { }
+  StepOrg(const StepOrg &) = default;
+
+  struct ManagerData : public mabe::Organism::ManagerData {
+    size_t slice_every = 0;  ///< How often to end a time slice (0 = never).
+  };
+
+  size_t Mutate(emp::Random &) override { return 0; }
+  void Initialize(emp::Random &) override { steps = 0; }
+
+  bool ProcessStep() override {
+    ++steps;
+    const size_t slice_every = SharedData().slice_every;
+    if (slice_every && steps % slice_every == 0) EndTimeSlice();
+    return true;
+  }
+
+  void SetupModule() override {
+    GetManager().AddSharedTrait<double>("merit", "Merit used by the scheduler.", 1.0);
+  }
+};
+
+struct SchedulerSetup {
+  mabe::MABE control{0, nullptr};
+  mabe::OrganismManager<StepOrg> & manager;
+  mabe::SchedulerProbabilistic & scheduler;
+  mabe::Population & pop;
+
+  SchedulerSetup(size_t num_orgs, bool time_slice)
+    : manager(control.AddModule<mabe::OrganismManager<StepOrg>>("StepOrg", "Test organisms."))
+    , scheduler(control.AddModule<mabe::SchedulerProbabilistic>("scheduler", "Test scheduler.",
+                                                                  "merit", 30))
+    , pop(control.AddPopulation("main_pop"))
+  {
+    scheduler.SetTimeSlice(time_slice);
+    control.Setup();
+    control.GetRandom().ResetSeed(42);
+    control.Inject(pop, "StepOrg", num_orgs);
+  }
+
+  size_t GetSteps(size_t pos) { return dynamic_cast<StepOrg &>(pop[pos]).steps; }
+  size_t GetTotalSteps() {
+    size_t total = 0;
+    for (size_t pos = 0; pos < pop.GetSize(); ++pos) total += GetSteps(pos);
+    return total;
+  }
+};
+
+TEST_CASE("SchedulerProbabilistic_Steps", "[select]"){
+  // With equal merits, each organism expects exactly avg_updates (30) steps per round.
+  {
+    SchedulerSetup setup(20, false);
+    setup.scheduler.Schedule();
+    CHECK(setup.GetTotalSteps() == 20 * 30);
+  }
+
+  // In time_slice mode, every organism gets its full slice, even if it ends it early.
+  {
+    SchedulerSetup setup(20, true);
+    setup.manager.GetManagedData().slice_every = 7;
+    setup.scheduler.Schedule();
+    for (size_t pos = 0; pos < 20; ++pos) CHECK(setup.GetSteps(pos) == 30);
+  }
+}
+
+TEST_CASE("SchedulerProbabilistic_Timing", "[select]"){
+  // Timings are only printed; they depend too much on the machine and build flags to check.
+  constexpr size_t NUM_ORGS = 200;
+  constexpr size_t NUM_ROUNDS = 100;
+  for (bool time_slice : {false, true}) {
+    SchedulerSetup setup(NUM_ORGS, time_slice);
+    setup.manager.GetManagedData().slice_every = 50;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) setup.scheduler.Schedule();
+    const std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+    const size_t total_steps = setup.GetTotalSteps();
+    std::cout << (time_slice ? "time_slice" : "per_step") << " mode: " << total_steps
+              << " steps in " << secs.count() << " s ("
+              << ((double) total_steps / secs.count()) << " steps per second)" << std::endl;
+    CHECK(total_steps > 0);
+  }
+}